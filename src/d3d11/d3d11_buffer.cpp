@@ -94,6 +94,10 @@ namespace dxvk {
     // we can put dynamic resources that need fast access by the GPU
     if (pDesc->Usage == D3D11_USAGE_DYNAMIC && pDesc->BindFlags)
       memoryFlags |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    
+    // Dynamic buffers are the only ones that get renamed
+    // on a regular basis when the app maps them
+    info.discardable = pDesc->Usage == D3D11_USAGE_DYNAMIC;
 
     // Create the buffer and set the entire buffer slice as mapped,
     // so that we only have to update it when invalidating th buffer
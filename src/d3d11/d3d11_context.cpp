@@ -105,7 +105,18 @@ namespace dxvk {
     if (rtv) view = rtv->GetImageView();
     if (uav) view = uav->GetImageView();
 
-    if (view != nullptr) {
+    if (view == nullptr)
+      return;
+
+    // Render target views can be discarded by
+    // the load ops of the next render pass
+    if (dsv || rtv) {
+      EmitCs([cView = std::move(view)]
+      (DxvkContext* ctx) {
+        ctx->discardImageView(cView,
+          cView->info().aspect);
+      });
+    } else {
       EmitCs([cView = std::move(view)]
       (DxvkContext* ctx) {
         ctx->discardImage(
@@ -283,15 +294,12 @@ namespace dxvk {
   void STDMETHODCALLTYPE D3D11DeviceContext::SetPredication(
           ID3D11Predicate*                  pPredicate,
           BOOL                              PredicateValue) {
-    static bool s_errorShown = false;
-    
-    if (pPredicate && !std::exchange(s_errorShown, true))
-      Logger::err("D3D11DeviceContext::SetPredication: Stub");
-    
     D3D10DeviceLock lock = LockContext();
     
     m_state.pr.predicateObject = static_cast<D3D11Query*>(pPredicate);
     m_state.pr.predicateValue  = PredicateValue;
+    
+    ApplyPredicate();
   }
   
   
@@ -384,7 +392,7 @@ namespace dxvk {
       regLength = std::min(regLength, srcBuffer.length() - srcOffset);
       regLength = std::min(regLength, dstBuffer.length() - dstOffset);
       
-      EmitCs([
+      EmitPredicatedCs([
         cDstSlice = dstBuffer.subSlice(dstOffset, regLength),
         cSrcSlice = srcBuffer.subSlice(srcOffset, regLength)
       ] (DxvkContext* ctx) {
@@ -523,7 +531,7 @@ namespace dxvk {
         return;
       }
       
-      EmitCs([
+      EmitPredicatedCs([
         cDstImage  = dstImage,
         cSrcImage  = srcImage,
         cDstLayers = dstLayers,
@@ -585,7 +593,7 @@ namespace dxvk {
         return;
       }
       
-      EmitCs([
+      EmitPredicatedCs([
         cDstBuffer = std::move(dstBuffer),
         cSrcBuffer = std::move(srcBuffer)
       ] (DxvkContext* ctx) {
@@ -633,7 +641,7 @@ namespace dxvk {
         
         VkExtent3D extent = srcImage->mipLevelExtent(i);
         
-        EmitCs([
+        EmitPredicatedCs([
           cDstImage  = dstImage,
           cSrcImage  = srcImage,
           cDstLayers = dstLayers,
@@ -662,7 +670,7 @@ namespace dxvk {
     if (!buf || !uav)
       return;
 
-    EmitCs([
+    EmitPredicatedCs([
       cDstSlice = buf->GetBufferSlice(DstAlignedByteOffset),
       cSrcSlice = uav->GetCounterSlice()
     ] (DxvkContext* ctx) {
@@ -694,7 +702,7 @@ namespace dxvk {
     clearValue.color.float32[2] = ColorRGBA[2];
     clearValue.color.float32[3] = ColorRGBA[3];
     
-    EmitCs([
+    EmitPredicatedCs([
       cClearValue = clearValue,
       cImageView  = view
     ] (DxvkContext* ctx) {
@@ -752,7 +760,7 @@ namespace dxvk {
       if (bufferView->info().format == VK_FORMAT_R32_UINT
        || bufferView->info().format == VK_FORMAT_R32_SINT
        || bufferView->info().format == VK_FORMAT_R32_SFLOAT) {
-        EmitCs([
+        EmitPredicatedCs([
           cClearValue = Values[0],
           cDstSlice   = bufferView->slice()
         ] (DxvkContext* ctx) {
@@ -772,7 +780,7 @@ namespace dxvk {
             bufferView->buffer(), info);
         }
         
-        EmitCs([
+        EmitPredicatedCs([
           cClearValue = clearValue,
           cDstView    = bufferView
         ] (DxvkContext* ctx) {
@@ -794,7 +802,7 @@ namespace dxvk {
           imageView->image(), info);
       }
       
-      EmitCs([
+      EmitPredicatedCs([
         cClearValue = clearValue,
         cDstView    = imageView
       ] (DxvkContext* ctx) {
@@ -824,7 +832,7 @@ namespace dxvk {
     clearValue.color.float32[3] = Values[3];
     
     if (uav->GetResourceType() == D3D11_RESOURCE_DIMENSION_BUFFER) {
-      EmitCs([
+      EmitPredicatedCs([
         cClearValue = clearValue,
         cDstView    = uav->GetBufferView()
       ] (DxvkContext* ctx) {
@@ -834,7 +842,7 @@ namespace dxvk {
           cClearValue.color);
       });
     } else {
-      EmitCs([
+      EmitPredicatedCs([
         cClearValue = clearValue,
         cDstView    = uav->GetImageView()
       ] (DxvkContext* ctx) {
@@ -877,7 +885,7 @@ namespace dxvk {
     clearValue.depthStencil.depth   = Depth;
     clearValue.depthStencil.stencil = Stencil;
     
-    EmitCs([
+    EmitPredicatedCs([
       cClearValue = clearValue,
       cAspectMask = aspectMask,
       cImageView  = view
@@ -969,7 +977,7 @@ namespace dxvk {
         VkDeviceSize offset = pRect[i].left;
         VkDeviceSize length = pRect[i].right - pRect[i].left;
 
-        EmitCs([
+        EmitPredicatedCs([
           cBufferView   = bufView,
           cRangeOffset  = offset,
           cRangeLength  = length,
@@ -989,7 +997,7 @@ namespace dxvk {
           uint32_t(pRect[i].right - pRect[i].left),
           uint32_t(pRect[i].bottom - pRect[i].top), 1 };
         
-        EmitCs([
+        EmitPredicatedCs([
           cImageView    = imgView,
           cAreaOffset   = offset,
           cAreaExtent   = extent,
@@ -1008,7 +1016,7 @@ namespace dxvk {
     // specified, we'll have to clear the entire view
     if (pRect == nullptr) {
       if (bufView != nullptr) {
-        EmitCs([
+        EmitPredicatedCs([
           cBufferView   = bufView,
           cClearValue   = clearValue,
           cElementSize  = formatInfo->elementSize
@@ -1021,7 +1029,7 @@ namespace dxvk {
       }
 
       if (imgView != nullptr) {
-        EmitCs([
+        EmitPredicatedCs([
           cImageView    = imgView,
           cClearValue   = clearValue
         ] (DxvkContext* ctx) {
@@ -1044,7 +1052,7 @@ namespace dxvk {
     if (!view || view->GetResourceType() == D3D11_RESOURCE_DIMENSION_BUFFER)
       return;
       
-    EmitCs([cDstImageView = view->GetImageView()]
+    EmitPredicatedCs([cDstImageView = view->GetImageView()]
     (DxvkContext* ctx) {
       ctx->generateMipmaps(cDstImageView);
     });
@@ -1109,8 +1117,10 @@ namespace dxvk {
       if (size == 0)
         return;
       
+      // Writing to the buffer on the CPU would bypass predication
       if (((size == bufferSlice.length())
-       && (bufferSlice.buffer()->memFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))) {
+       && (bufferSlice.buffer()->memFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+       && (m_state.pr.predicateObject == nullptr)) {
         D3D11_MAPPED_SUBRESOURCE mappedSr;
         Map(pDstResource, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSr);
         std::memcpy(mappedSr.pData, pSrcData, size);
@@ -1119,7 +1129,7 @@ namespace dxvk {
         DxvkDataSlice dataSlice = AllocUpdateBufferSlice(size);
         std::memcpy(dataSlice.ptr(), pSrcData, size);
         
-        EmitCs([
+        EmitPredicatedCs([
           cDataBuffer   = std::move(dataSlice),
           cBufferSlice  = bufferSlice.subSlice(offset, size)
         ] (DxvkContext* ctx) {
@@ -1177,7 +1187,7 @@ namespace dxvk {
         regionExtent, formatInfo->elementSize,
         SrcRowPitch, SrcDepthPitch);
       
-      EmitCs([
+      EmitPredicatedCs([
         cDstImage         = textureInfo->GetImage(),
         cDstLayers        = layers,
         cDstOffset        = offset,
@@ -1281,7 +1291,7 @@ namespace dxvk {
       srcSubresource.arrayLayer, 1 };
     
     if (srcDesc.SampleDesc.Count == 1) {
-      EmitCs([
+      EmitPredicatedCs([
         cDstImage  = dstTextureInfo->GetImage(),
         cSrcImage  = srcTextureInfo->GetImage(),
         cDstLayers = dstSubresourceLayers,
@@ -1296,7 +1306,7 @@ namespace dxvk {
       const VkFormat format = m_parent->LookupFormat(
         Format, DXGI_VK_FORMAT_MODE_ANY).Format;
       
-      EmitCs([
+      EmitPredicatedCs([
         cDstImage  = dstTextureInfo->GetImage(),
         cSrcImage  = srcTextureInfo->GetImage(),
         cDstSubres = dstSubresourceLayers,
@@ -3100,6 +3110,32 @@ namespace dxvk {
   }
   
   
+  void D3D11DeviceContext::ApplyPredicate() {
+    D3D11Query* predicate = m_state.pr.predicateObject.ptr();
+    
+    DxvkBufferSlice predicateSlice;
+    
+    // The predicate is never evaluated at record time since the
+    // query may still be pending or get restarted before the CS
+    // thread, or a deferred command list, reaches this point.
+    if (predicate != nullptr)
+      predicateSlice = predicate->GetPredicate();
+    
+    // Draws are skipped if the predicate data matches the
+    // predicate value, i.e. for a value of TRUE, we need
+    // to invert the condition for conditional rendering
+    VkConditionalRenderingFlagsEXT flags = m_state.pr.predicateValue
+      ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0;
+    
+    EmitCs([
+      cPredicate = predicateSlice,
+      cFlags     = flags
+    ] (DxvkContext* ctx) {
+      ctx->setPredicate(cPredicate, cFlags);
+    });
+  }
+  
+  
   void D3D11DeviceContext::BindShader(
           DxbcProgramType       ShaderStage,
     const D3D11CommonShader*    pShaderModule) {
@@ -3508,6 +3544,7 @@ namespace dxvk {
     ApplyStencilRef();
     ApplyRasterizerState();
     ApplyViewportState();
+    ApplyPredicate();
 
     BindDrawBuffer(
       m_state.id.argBuffer.ptr());
@@ -681,6 +681,8 @@ namespace dxvk {
     
     void ApplyViewportState();
     
+    void ApplyPredicate();
+    
     void BindShader(
             DxbcProgramType                   ShaderStage,
       const D3D11CommonShader*                pShaderModule);
@@ -826,6 +828,20 @@ namespace dxvk {
       }
     }
 
+    template<typename Cmd>
+    void EmitPredicatedCs(Cmd&& command) {
+      if (likely(m_state.pr.predicateObject == nullptr)) {
+        EmitCs(std::forward<Cmd>(command));
+      } else {
+        EmitCs([
+          cCommand = std::forward<Cmd>(command)
+        ] (DxvkContext* ctx) {
+          if (ctx->testPredicate())
+            cCommand(ctx);
+        });
+      }
+    }
+
     template<typename M, typename Cmd, typename... Args>
     M* EmitCsCmd(Cmd&& command, Args&&... args) {
       M* data = m_csChunk->pushCmd<M, Cmd, Args...>(
@@ -12,7 +12,7 @@ namespace dxvk {
           D3D11Device*    pParent,
     const Rc<DxvkDevice>& Device)
   : D3D11DeviceContext(pParent, Device, DxvkCsChunkFlag::SingleUse),
-    m_csThread(Device->createContext()) {
+    m_csThread(Device, Device->createContext()) {
     EmitCs([
       cDevice          = m_device,
       cRelaxedBarriers = pParent->GetOptions()->relaxedBarriers
@@ -557,7 +557,12 @@ namespace dxvk {
     // recorded prior to this function will be run
     FlushCsChunk();
     
+    auto t0 = std::chrono::high_resolution_clock::now();
     m_csThread.synchronize();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    m_device->addStatCtr(DxvkStatCounter::CsSyncTime,
+      std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
   }
   
   
@@ -592,8 +597,15 @@ namespace dxvk {
         Flush();
         SynchronizeCsThread();
         
+        auto t0 = std::chrono::high_resolution_clock::now();
+        
         while (Resource->isInUse())
           dxvk::this_thread::yield();
+        
+        auto t1 = std::chrono::high_resolution_clock::now();
+        
+        m_device->addStatCtr(DxvkStatCounter::GpuSyncTime,
+          std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
       }
     }
     
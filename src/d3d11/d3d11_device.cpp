@@ -39,6 +39,13 @@ namespace dxvk {
     m_d3d11Formats  (m_dxvkAdapter),
     m_d3d11Options  (m_dxvkAdapter->instance()->config()),
     m_dxbcOptions   (m_dxvkDevice, m_d3d11Options) {
+    // Shader behaviour that is selected via spec constants.
+    // This must happen before any shaders get registered.
+    m_dxvkDevice->setSpecConstant(DxvkSpecConstantId::StrictDivision,
+      m_d3d11Options.strictDivision ? VK_TRUE : VK_FALSE);
+    m_dxvkDevice->setSpecConstant(DxvkSpecConstantId::ZeroInitWorkgroupMemory,
+      m_d3d11Options.zeroInitWorkgroupMemory ? VK_TRUE : VK_FALSE);
+    
     m_initializer = new D3D11Initializer(m_dxvkDevice);
     m_context     = new D3D11ImmediateContext(this, m_dxvkDevice);
     m_d3d10Device = new D3D10Device(this, m_context);
@@ -426,11 +433,8 @@ namespace dxvk {
       return E_INVALIDARG;
     
     try {
-      DxbcReader dxbcReader(reinterpret_cast<const char*>(
-        pShaderBytecodeWithInputSignature), BytecodeLength);
-      DxbcModule dxbcModule(dxbcReader);
-      
-      const Rc<DxbcIsgn> inputSignature = dxbcModule.isgn();
+      const Rc<DxbcIsgn> inputSignature = m_inputSignatures.GetInputSignature(
+        pShaderBytecodeWithInputSignature, BytecodeLength);
 
       uint32_t attrMask = 0;
       uint32_t bindMask = 0;
@@ -444,10 +448,10 @@ namespace dxvk {
           pInputElementDescs[i].SemanticIndex, 0);
         
         if (entry == nullptr) {
-          Logger::debug(str::format(
+          Logger::log(LogLevel::Debug,
             "D3D11Device: No such vertex shader semantic: ",
             pInputElementDescs[i].SemanticName,
-            pInputElementDescs[i].SemanticIndex));
+            pInputElementDescs[i].SemanticIndex);
         }
         
         // Create vertex input attribute description
@@ -1391,6 +1395,7 @@ namespace dxvk {
       enabled.core.features.logicOp                               = supported.core.features.logicOp;
       enabled.core.features.shaderImageGatherExtended             = VK_TRUE;
       enabled.core.features.variableMultisampleRate               = supported.core.features.variableMultisampleRate;
+      enabled.extConditionalRendering.conditionalRendering        = supported.extConditionalRendering.conditionalRendering;
       enabled.extTransformFeedback.transformFeedback              = supported.extTransformFeedback.transformFeedback;
       enabled.extTransformFeedback.geometryStreams                = supported.extTransformFeedback.geometryStreams;
     }
@@ -362,6 +362,7 @@ namespace dxvk {
     D3D11StateObjectSet<D3D11RasterizerState>   m_rsStateObjects;
     D3D11StateObjectSet<D3D11SamplerState>      m_samplerObjects;
     D3D11ShaderModuleSet                        m_shaderModules;
+    D3D11InputSignatureSet                      m_inputSignatures;
     
     Rc<D3D11CounterBuffer> CreateUAVCounterBuffer();
     Rc<D3D11CounterBuffer> CreateXFBCounterBuffer();
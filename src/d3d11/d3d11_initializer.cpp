@@ -9,6 +9,12 @@ namespace dxvk {
   : m_device(Device), m_context(m_device->createContext()) {
     m_context->beginRecording(
       m_device->createCommandList());
+    
+    if (m_device->hasDedicatedTransferQueue()) {
+      m_transfer = m_device->createTransferContext();
+      m_transfer->beginRecording(
+        m_device->createTransferCommandList());
+    }
   }
 
   
@@ -57,11 +63,19 @@ namespace dxvk {
       m_transferMemory   += bufferSlice.length();
       m_transferCommands += 1;
       
-      m_context->updateBuffer(
-        bufferSlice.buffer(),
-        bufferSlice.offset(),
-        bufferSlice.length(),
-        pInitialData->pSysMem);
+      if (m_transfer != nullptr) {
+        m_transfer->uploadBuffer(
+          bufferSlice.buffer(),
+          bufferSlice.offset(),
+          bufferSlice.length(),
+          pInitialData->pSysMem);
+      } else {
+        m_context->updateBuffer(
+          bufferSlice.buffer(),
+          bufferSlice.offset(),
+          bufferSlice.length(),
+          pInitialData->pSysMem);
+      }
     } else {
       m_transferCommands += 1;
 
@@ -131,13 +145,22 @@ namespace dxvk {
           m_transferMemory   += util::computeImageDataSize(
             image->info().format, mipLevelExtent);
           
-          m_context->updateImage(
-            image, subresourceLayers,
-            mipLevelOffset,
-            mipLevelExtent,
-            pInitialData[id].pSysMem,
-            pInitialData[id].SysMemPitch,
-            pInitialData[id].SysMemSlicePitch);
+          if (m_transfer != nullptr) {
+            m_transfer->uploadImage(
+              image, subresourceLayers,
+              mipLevelExtent,
+              pInitialData[id].pSysMem,
+              pInitialData[id].SysMemPitch,
+              pInitialData[id].SysMemSlicePitch);
+          } else {
+            m_context->updateImage(
+              image, subresourceLayers,
+              mipLevelOffset,
+              mipLevelExtent,
+              pInitialData[id].pSysMem,
+              pInitialData[id].SysMemPitch,
+              pInitialData[id].SysMemSlicePitch);
+          }
         }
       }
     } else {
@@ -193,6 +216,9 @@ namespace dxvk {
 
 
   void D3D11Initializer::FlushInternal() {
+    if (m_transfer != nullptr)
+      m_transfer->flushCommandList(m_context);
+    
     m_context->flushCommandList();
     
     m_transferCommands = 0;
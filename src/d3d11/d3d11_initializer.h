@@ -12,6 +12,10 @@ namespace dxvk {
    * initialization. This includes initialization
    * with application-defined data, as well as
    * zero-initialization for buffers and images.
+   * 
+   * If the device has a dedicated transfer queue,
+   * initial data is uploaded on that queue so that
+   * large uploads do not stall rendering.
    */
   class D3D11Initializer {
     constexpr static size_t MaxTransferMemory    = 32 * 1024 * 1024;
@@ -39,6 +43,7 @@ namespace dxvk {
 
     Rc<DxvkDevice>    m_device;
     Rc<DxvkContext>   m_context;
+    Rc<DxvkTransferContext> m_transfer;
 
     size_t            m_transferCommands  = 0;
     size_t            m_transferMemory    = 0;
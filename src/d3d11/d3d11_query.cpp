@@ -22,6 +22,7 @@ namespace dxvk {
       case D3D11_QUERY_OCCLUSION_PREDICATE:
         m_query = new DxvkQuery(
           VK_QUERY_TYPE_OCCLUSION, 0);
+        m_predicate = CreatePredicateBuffer();
         break;
         
       case D3D11_QUERY_TIMESTAMP:
@@ -198,6 +199,9 @@ namespace dxvk {
     if (m_query != nullptr) {
       DxvkQueryRevision rev = { m_query, m_revision };
       ctx->endQuery(rev);
+      
+      if (m_predicate.defined())
+        ctx->writePredicate(m_predicate, rev);
     }
   }
   
@@ -308,6 +312,37 @@ namespace dxvk {
   }
   
   
+  DxvkBufferSlice D3D11Query::CreatePredicateBuffer() {
+    Rc<DxvkDevice> device = m_device->GetDXVKDevice();
+    
+    DxvkBufferCreateInfo info;
+    info.size   = sizeof(uint32_t);
+    info.usage  = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    info.stages = VK_PIPELINE_STAGE_TRANSFER_BIT
+                | VK_PIPELINE_STAGE_HOST_BIT;
+    info.access = VK_ACCESS_TRANSFER_WRITE_BIT
+                | VK_ACCESS_HOST_READ_BIT;
+    
+    // Without conditional rendering, draws evaluate the
+    // predicate on the CPU just like copies and clears do
+    if (device->features().extConditionalRendering.conditionalRendering) {
+      info.usage  |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+      info.stages |= VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
+      info.access |= VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT;
+    }
+    
+    // Copies and clears evaluate the predicate on the CPU,
+    // see DxvkContext::testPredicate. Until the query is
+    // ended for the first time, predicated work executes.
+    DxvkBufferSlice slice(device->createBuffer(info,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+    
+    *reinterpret_cast<uint32_t*>(slice.mapPtr(0)) = 1;
+    return slice;
+  }
+  
+  
   UINT64 D3D11Query::GetTimestampQueryFrequency() const {
     Rc<DxvkDevice>  device  = m_device->GetDXVKDevice();
     Rc<DxvkAdapter> adapter = device->adapter();
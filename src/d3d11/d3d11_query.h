@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../dxvk/dxvk_buffer.h"
 #include "../dxvk/dxvk_event.h"
 #include "../dxvk/dxvk_query.h"
 
@@ -45,6 +46,10 @@ namespace dxvk {
             void*                             pData,
             UINT                              GetDataFlags);
     
+    DxvkBufferSlice GetPredicate() const {
+      return m_predicate;
+    }
+    
     D3D10Query* GetD3D10Iface() {
       return &m_d3d10;
     }
@@ -57,10 +62,14 @@ namespace dxvk {
     Rc<DxvkQuery> m_query = nullptr;
     Rc<DxvkEvent> m_event = nullptr;
     
+    DxvkBufferSlice m_predicate;
+    
     uint32_t m_revision = 0;
 
     D3D10Query m_d3d10;
 
+    DxvkBufferSlice CreatePredicateBuffer();
+    
     UINT64 GetTimestampQueryFrequency() const;
     
   };
@@ -14,7 +14,7 @@ namespace dxvk {
     const void*           pShaderBytecode,
           size_t          BytecodeLength) {
     const std::string name = pShaderKey->toString();
-    Logger::debug(str::format("Compiling shader ", name));
+    Logger::log(LogLevel::Debug, "Compiling shader ", name);
     
     DxbcReader reader(
       reinterpret_cast<const char*>(pShaderBytecode),
@@ -111,4 +111,47 @@ namespace dxvk {
     return module;
   }
   
+  
+  D3D11InputSignatureSet:: D3D11InputSignatureSet() { }
+  D3D11InputSignatureSet::~D3D11InputSignatureSet() { }
+  
+  
+  Rc<DxbcIsgn> D3D11InputSignatureSet::GetInputSignature(
+    const void*           pShaderBytecode,
+          size_t          BytecodeLength) {
+    // The checksum in the DXBC header is not reliable since
+    // some tools zero it out, so hash the entire byte code.
+    DxvkShaderKey key(VK_SHADER_STAGE_VERTEX_BIT,
+      Sha1Hash::compute(pShaderBytecode, BytecodeLength));
+    
+    { std::unique_lock<std::mutex> lock(m_mutex);
+      
+      auto entry = m_signatures.find(key);
+      if (entry != m_signatures.end())
+        return entry->second;
+    }
+    
+    // Only read the container header and the signature chunk,
+    // the instruction stream is not needed for input layouts.
+    DxbcContainerView container(pShaderBytecode, BytecodeLength);
+    Rc<DxbcIsgn> signature = container.isgn();
+    
+    if (signature == nullptr)
+      throw DxvkError("D3D11: No input signature found in shader");
+    
+    { std::unique_lock<std::mutex> lock(m_mutex);
+      
+      // Input layouts are usually created up front, so keep
+      // the cache bounded rather than tracking recent use
+      if (m_signatures.size() >= MaxSignatureCount)
+        m_signatures.clear();
+      
+      auto status = m_signatures.insert({ key, signature });
+      if (!status.second)
+        return status.first->second;
+    }
+    
+    return signature;
+  }
+  
 }
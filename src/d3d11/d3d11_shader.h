@@ -3,6 +3,7 @@
 #include <mutex>
 #include <unordered_map>
 
+#include "../dxbc/dxbc_container.h"
 #include "../dxbc/dxbc_module.h"
 #include "../dxvk/dxvk_device.h"
 
@@ -158,4 +159,37 @@ namespace dxvk {
     
   };
   
+  
+  /**
+   * \brief Input signature set
+   * 
+   * Caches parsed input signatures of vertex shaders so
+   * that creating many input layouts for the same shader
+   * does not parse the byte code every time. Signatures
+   * are identified by a hash of the full byte code.
+   * This class is thread-safe.
+   */
+  class D3D11InputSignatureSet {
+    /// Number of signatures after which the cache is reset
+    constexpr static size_t MaxSignatureCount = 4096;
+  public:
+    
+    D3D11InputSignatureSet();
+    ~D3D11InputSignatureSet();
+    
+    Rc<DxbcIsgn> GetInputSignature(
+      const void*           pShaderBytecode,
+            size_t          BytecodeLength);
+    
+  private:
+    
+    std::mutex m_mutex;
+    
+    std::unordered_map<
+      DxvkShaderKey,
+      Rc<DxbcIsgn>,
+      DxvkHash, DxvkEq> m_signatures;
+    
+  };
+  
 }
@@ -24,10 +24,14 @@ namespace dxvk {
     m_window    (hWnd),
     m_desc      (*pDesc),
     m_device    (pDevice->GetDXVKDevice()),
-    m_context   (m_device->createContext()) {
+    m_context   (m_device->createContext()),
+    m_presentContext(m_device->createContext()) {
     if (!pDevice->GetOptions()->deferSurfaceCreation)
       CreatePresenter();
     
+    m_fpsLimiter.setTargetFrameRate(
+      double(pDevice->GetOptions()->maxFrameRate));
+    
     CreateBackBuffer();
     CreateHud();
     
@@ -36,10 +40,19 @@ namespace dxvk {
     InitShaders();
 
     SetGammaControl(0, nullptr);
+
+    m_presentThread = dxvk::thread([this] () { PresentThread(); });
   }
 
 
   D3D11SwapChain::~D3D11SwapChain() {
+    { std::unique_lock<std::mutex> lock(m_presentMutex);
+      m_presentStopped = true;
+    }
+
+    m_presentCondOnAdd.notify_one();
+    m_presentThread.join();
+
     m_device->waitForIdle();
     
     if (m_backBuffer)
@@ -109,6 +122,9 @@ namespace dxvk {
 
   HRESULT STDMETHODCALLTYPE D3D11SwapChain::ChangeProperties(
     const DXGI_SWAP_CHAIN_DESC1*  pDesc) {
+    // The present thread may still read the
+    // swap chain description and present images
+    SynchronizePresent();
 
     m_dirty |= m_desc.Format      != pDesc->Format
             || m_desc.Width       != pDesc->Width
@@ -177,9 +193,6 @@ namespace dxvk {
     if (m_presenter == nullptr)
       CreatePresenter();
 
-    if (std::exchange(m_dirty, false))
-      RecreateSwapChain(vsync);
-    
     FlushImmediateContext();
 
     try {
@@ -193,31 +206,160 @@ namespace dxvk {
 
 
   void D3D11SwapChain::PresentImage(UINT SyncInterval) {
+    TraceZone zone("Present");
+
     // Wait for the sync event so that we
     // respect the maximum frame latency
     Rc<DxvkEvent> syncEvent = m_dxgiDevice->GetFrameSyncEvent();
-    syncEvent->wait();
+
+    { TraceZone waitZone("Frame latency wait");
+      syncEvent->wait();
+    }
+
+    uint32_t frameId = m_presentFrameId++;
+
+    // With a frame rate limit in place, only let the application
+    // run as far ahead as necessary to keep the GPU busy, based
+    // on how long it currently takes for submissions to complete.
+    if (m_fpsLimiter.isEnabled()) {
+      uint32_t frameLatency = m_fpsLimiter.frameLatency(
+        m_device->gpuLatency(), m_presentImages.size());
+
+      if (frameId >= frameLatency) {
+        const Rc<DxvkEvent>& prevEvent = m_frameEvents[
+          (frameId - frameLatency) % m_frameEvents.size()];
+
+        if (prevEvent != nullptr)
+          prevEvent->wait();
+      }
+
+      m_fpsLimiter.delay();
+    }
+
+    m_frameEvents[frameId % m_frameEvents.size()] = syncEvent;
+
+    D3D11PresentRequest request;
+    request.imageId       = frameId % m_presentImages.size();
+    request.syncInterval  = SyncInterval;
+    request.vsync         = m_vsync;
+    request.recreate      = std::exchange(m_dirty, false);
+    request.pacingError   = m_fpsLimiter.pacingError().count();
+    request.gammaView     = m_gammaTextureView;
+
+    // Each queued present owns one present image, so we can only
+    // reuse the image once the present thread has submitted the
+    // command list that reads from it.
+    { std::unique_lock<std::mutex> lock(m_presentMutex);
+
+      m_presentCondOnTake.wait(lock, [this] {
+        return m_presentQueue.size() < m_presentImages.size();
+      });
+    }
+
+    // Copy the back buffer to the present image on the calling
+    // thread so that rendering commands submitted after this
+    // call cannot affect the contents of the presented image.
+    m_context->beginRecording(
+      m_device->createCommandList());
     
-    if (m_hud != nullptr)
+    VkImageSubresourceLayers subresources;
+    subresources.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+    subresources.mipLevel        = 0;
+    subresources.baseArrayLayer  = 0;
+    subresources.layerCount      = 1;
+
+    const Rc<DxvkImage>& presentImage = m_presentImages[request.imageId];
+
+    if (m_swapImage->info().sampleCount != VK_SAMPLE_COUNT_1_BIT) {
+      m_context->resolveImage(
+        presentImage, subresources,
+        m_swapImage,  subresources,
+        VK_FORMAT_UNDEFINED);
+    } else {
+      m_context->copyImage(
+        presentImage, subresources, VkOffset3D { 0, 0, 0 },
+        m_swapImage,  subresources, VkOffset3D { 0, 0, 0 },
+        m_swapImage->info().extent);
+    }
+
+    m_device->submitCommandList(
+      m_context->endRecording(),
+      VK_NULL_HANDLE,
+      VK_NULL_HANDLE);
+
+    request.syncEvent.event     = syncEvent;
+    request.syncEvent.revision  = syncEvent->reset();
+
+    { std::unique_lock<std::mutex> lock(m_presentMutex);
+      m_presentQueue.push(std::move(request));
+      m_presentCondOnAdd.notify_one();
+    }
+  }
+
+
+  void D3D11SwapChain::PresentThread() {
+    env::setThreadName("dxvk-present");
+
+    while (true) {
+      D3D11PresentRequest request;
+
+      { std::unique_lock<std::mutex> lock(m_presentMutex);
+
+        m_presentCondOnAdd.wait(lock, [this] {
+          return m_presentStopped || !m_presentQueue.empty();
+        });
+
+        // Process all pending requests before exiting
+        // so that nobody waits on the sync event forever
+        if (m_presentQueue.empty())
+          break;
+
+        request = m_presentQueue.front();
+      }
+
+      try {
+        ExecutePresent(request);
+      } catch (const DxvkError& e) {
+        Logger::err(e.message());
+
+        request.syncEvent.event->signal(
+          request.syncEvent.revision);
+      }
+
+      { std::unique_lock<std::mutex> lock(m_presentMutex);
+        m_presentQueue.pop();
+        m_presentCondOnTake.notify_all();
+      }
+    }
+  }
+
+
+  void D3D11SwapChain::ExecutePresent(
+    const D3D11PresentRequest&      Request) {
+    TraceZone zone("Execute present");
+
+    if (Request.recreate)
+      RecreateSwapChain(Request.vsync);
+
+    if (m_hud != nullptr) {
       m_hud->update();
+      m_hud->updatePacing(Request.pacingError);
+    }
 
-    for (uint32_t i = 0; i < SyncInterval || i < 1; i++) {
-      m_context->beginRecording(
+    for (uint32_t i = 0; i < Request.syncInterval || i < 1; i++) {
+      m_presentContext->beginRecording(
         m_device->createCommandList());
       
-      // Resolve back buffer if it is multisampled. We
-      // only have to do it only for the first frame.
-      if (m_swapImageResolve != nullptr && i == 0) {
-        VkImageSubresourceLayers resolveSubresources;
-        resolveSubresources.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
-        resolveSubresources.mipLevel        = 0;
-        resolveSubresources.baseArrayLayer  = 0;
-        resolveSubresources.layerCount      = 1;
+      // The present image and gamma texture were written by
+      // command lists submitted from the application thread,
+      // which this context does not know about. Make those
+      // writes visible to the fragment shader explicitly.
+      if (i == 0) {
+        AcquirePresentImage(m_presentImages[Request.imageId]);
+        AcquirePresentImage(Request.gammaView->image());
         
-        m_context->resolveImage(
-          m_swapImageResolve, resolveSubresources,
-          m_swapImage,        resolveSubresources,
-          VK_FORMAT_UNDEFINED);
+        m_presentContext->acquireResources(VK_NULL_HANDLE,
+          m_presentBarriers, m_presentResources);
       }
       
       // Presentation semaphores and WSI swap chain image
@@ -230,7 +372,7 @@ namespace dxvk {
         sync.acquire, sync.fence, imageIndex);
 
       while (status != VK_SUCCESS && status != VK_SUBOPTIMAL_KHR) {
-        RecreateSwapChain(m_vsync);
+        RecreateSwapChain(Request.vsync);
         
         info = m_presenter->info();
         sync = m_presenter->getSyncSemaphores();
@@ -244,16 +386,18 @@ namespace dxvk {
 
       // Use an appropriate texture filter depending on whether
       // the back buffer size matches the swap image size
-      bool fitSize = m_swapImage->info().extent.width  == info.imageExtent.width
-                  && m_swapImage->info().extent.height == info.imageExtent.height;
+      const Rc<DxvkImageView>& presentView = m_presentImageViews[Request.imageId];
 
-      m_context->bindShader(VK_SHADER_STAGE_VERTEX_BIT,   m_vertShader);
-      m_context->bindShader(VK_SHADER_STAGE_FRAGMENT_BIT, m_fragShader);
+      bool fitSize = presentView->imageInfo().extent.width  == info.imageExtent.width
+                  && presentView->imageInfo().extent.height == info.imageExtent.height;
+
+      m_presentContext->bindShader(VK_SHADER_STAGE_VERTEX_BIT,   m_vertShader);
+      m_presentContext->bindShader(VK_SHADER_STAGE_FRAGMENT_BIT, m_fragShader);
 
       DxvkRenderTargets renderTargets;
       renderTargets.color[0].view   = m_imageViews.at(imageIndex);
       renderTargets.color[0].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-      m_context->bindRenderTargets(renderTargets, false);
+      m_presentContext->bindRenderTargets(renderTargets, false);
 
       VkViewport viewport;
       viewport.x        = 0.0f;
@@ -269,47 +413,74 @@ namespace dxvk {
       scissor.extent.width  = info.imageExtent.width;
       scissor.extent.height = info.imageExtent.height;
 
-      m_context->setViewports(1, &viewport, &scissor);
+      m_presentContext->setViewports(1, &viewport, &scissor);
 
-      m_context->setRasterizerState(m_rsState);
-      m_context->setMultisampleState(m_msState);
-      m_context->setDepthStencilState(m_dsState);
-      m_context->setLogicOpState(m_loState);
-      m_context->setBlendMode(0, m_blendMode);
+      m_presentContext->setRasterizerState(m_rsState);
+      m_presentContext->setMultisampleState(m_msState);
+      m_presentContext->setDepthStencilState(m_dsState);
+      m_presentContext->setLogicOpState(m_loState);
+      m_presentContext->setBlendMode(0, m_blendMode);
       
-      m_context->setInputAssemblyState(m_iaState);
-      m_context->setInputLayout(0, nullptr, 0, nullptr);
+      m_presentContext->setInputAssemblyState(m_iaState);
+      m_presentContext->setInputLayout(0, nullptr, 0, nullptr);
 
-      m_context->bindResourceSampler(BindingIds::Sampler, fitSize ? m_samplerFitting : m_samplerScaling);
-      m_context->bindResourceSampler(BindingIds::GammaSmp, m_gammaSampler);
+      m_presentContext->bindResourceSampler(BindingIds::Sampler, fitSize ? m_samplerFitting : m_samplerScaling);
+      m_presentContext->bindResourceSampler(BindingIds::GammaSmp, m_gammaSampler);
 
-      m_context->bindResourceView(BindingIds::Texture, m_swapImageView, nullptr);
-      m_context->bindResourceView(BindingIds::GammaTex, m_gammaTextureView, nullptr);
+      m_presentContext->bindResourceView(BindingIds::Texture, presentView, nullptr);
+      m_presentContext->bindResourceView(BindingIds::GammaTex, Request.gammaView, nullptr);
 
-      m_context->draw(4, 1, 0, 0);
+      m_presentContext->draw(4, 1, 0, 0);
 
       if (m_hud != nullptr)
-        m_hud->render(m_context, info.imageExtent);
+        m_hud->render(m_presentContext, info.imageExtent);
       
-      if (i + 1 >= SyncInterval) {
-        DxvkEventRevision eventRev;
-        eventRev.event    = syncEvent;
-        eventRev.revision = syncEvent->reset();
-        m_context->signalEvent(eventRev);
-      }
+      if (i + 1 >= Request.syncInterval)
+        m_presentContext->signalEvent(Request.syncEvent);
 
       m_device->submitCommandList(
-        m_context->endRecording(),
+        m_presentContext->endRecording(),
         sync.acquire, sync.present);
       
       status = m_device->presentImage(
         m_presenter, sync.present);
       
       if (status != VK_SUCCESS)
-        RecreateSwapChain(m_vsync);
+        RecreateSwapChain(Request.vsync);
     }
   }
 
+
+  void D3D11SwapChain::AcquirePresentImage(
+    const Rc<DxvkImage>&            Image) {
+    VkImageSubresourceRange subresources;
+    subresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    subresources.baseMipLevel   = 0;
+    subresources.levelCount     = Image->info().mipLevels;
+    subresources.baseArrayLayer = 0;
+    subresources.layerCount     = Image->info().numLayers;
+    
+    m_presentBarriers.accessImage(
+      Image, subresources,
+      Image->info().layout,
+      Image->info().stages,
+      Image->info().access,
+      Image->info().layout,
+      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT);
+    
+    m_presentResources.push_back(Image);
+  }
+
+
+  void D3D11SwapChain::SynchronizePresent() {
+    std::unique_lock<std::mutex> lock(m_presentMutex);
+
+    m_presentCondOnTake.wait(lock, [this] {
+      return m_presentQueue.empty();
+    });
+  }
+
   
   void D3D11SwapChain::RecreateSwapChain(BOOL Vsync) {
     vk::PresenterDesc presenterDesc;
@@ -410,8 +581,6 @@ namespace dxvk {
       m_backBuffer->ReleasePrivate();
     
     m_swapImage         = nullptr;
-    m_swapImageResolve  = nullptr;
-    m_swapImageView     = nullptr;
     m_backBuffer        = nullptr;
 
     // Create new back buffer
@@ -437,51 +606,10 @@ namespace dxvk {
 
     m_swapImage = GetCommonTexture(m_backBuffer)->GetImage();
 
-    // If the image is multisampled, we need to create
-    // another image which we'll use as a resolve target
-    if (m_swapImage->info().sampleCount != VK_SAMPLE_COUNT_1_BIT) {
-      DxvkImageCreateInfo resolveInfo;
-      resolveInfo.type          = VK_IMAGE_TYPE_2D;
-      resolveInfo.format        = m_swapImage->info().format;
-      resolveInfo.flags         = 0;
-      resolveInfo.sampleCount   = VK_SAMPLE_COUNT_1_BIT;
-      resolveInfo.extent        = m_swapImage->info().extent;
-      resolveInfo.numLayers     = 1;
-      resolveInfo.mipLevels     = 1;
-      resolveInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT
-                                | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
-                                | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-      resolveInfo.stages        = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
-                                | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
-                                | VK_PIPELINE_STAGE_TRANSFER_BIT;
-      resolveInfo.access        = VK_ACCESS_SHADER_READ_BIT
-                                | VK_ACCESS_TRANSFER_WRITE_BIT
-                                | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
-                                | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-      resolveInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
-      resolveInfo.layout        = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-      
-      m_swapImageResolve = m_device->createImage(
-        resolveInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    }
-
-    // Create an image view that allows the
-    // image to be bound as a shader resource.
-    DxvkImageViewCreateInfo viewInfo;
-    viewInfo.type       = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format     = m_swapImage->info().format;
-    viewInfo.usage      = VK_IMAGE_USAGE_SAMPLED_BIT;
-    viewInfo.aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.minLevel   = 0;
-    viewInfo.numLevels  = 1;
-    viewInfo.minLayer   = 0;
-    viewInfo.numLayers  = 1;
-    
-    m_swapImageView = m_device->createImageView(
-      m_swapImageResolve != nullptr
-        ? m_swapImageResolve
-        : m_swapImage,
-      viewInfo);
+    // Create the images that the present thread reads from.
+    // These also serve as resolve targets for multisampled
+    // back buffers, so they never use multisampling.
+    CreatePresentImages();
     
     // Initialize the image so that we can use it. Clearing
     // to black prevents garbled output for the first frame.
@@ -511,43 +639,91 @@ namespace dxvk {
   }
 
 
+  void D3D11SwapChain::CreatePresentImages() {
+    uint32_t imageCount = PickPresentQueueSize();
+
+    m_presentImages.clear();
+    m_presentImageViews.clear();
+
+    DxvkImageCreateInfo imageInfo;
+    imageInfo.type          = VK_IMAGE_TYPE_2D;
+    imageInfo.format        = m_swapImage->info().format;
+    imageInfo.flags         = 0;
+    imageInfo.sampleCount   = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.extent        = m_swapImage->info().extent;
+    imageInfo.numLayers     = 1;
+    imageInfo.mipLevels     = 1;
+    imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT
+                            | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                            | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.stages        = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                            | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+                            | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    imageInfo.access        = VK_ACCESS_SHADER_READ_BIT
+                            | VK_ACCESS_TRANSFER_WRITE_BIT
+                            | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+                            | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.layout        = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    DxvkImageViewCreateInfo viewInfo;
+    viewInfo.type       = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format     = m_swapImage->info().format;
+    viewInfo.usage      = VK_IMAGE_USAGE_SAMPLED_BIT;
+    viewInfo.aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.minLevel   = 0;
+    viewInfo.numLevels  = 1;
+    viewInfo.minLayer   = 0;
+    viewInfo.numLayers  = 1;
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+      Rc<DxvkImage> image = m_device->createImage(
+        imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+      m_presentImages.push_back(image);
+      m_presentImageViews.push_back(
+        m_device->createImageView(image, viewInfo));
+    }
+  }
+
+
   void D3D11SwapChain::CreateGammaTexture(
             UINT                NumControlPoints,
       const D3D11_VK_GAMMA_CP*  pControlPoints) {
-    if (m_gammaTexture == nullptr
-     || m_gammaTexture->info().extent.width != NumControlPoints) {
-      DxvkImageCreateInfo imgInfo;
-      imgInfo.type        = VK_IMAGE_TYPE_1D;
-      imgInfo.format      = VK_FORMAT_R16G16B16A16_UNORM;
-      imgInfo.flags       = 0;
-      imgInfo.sampleCount = VK_SAMPLE_COUNT_1_BIT;
-      imgInfo.extent      = { NumControlPoints, 1, 1 };
-      imgInfo.numLayers   = 1;
-      imgInfo.mipLevels   = 1;
-      imgInfo.usage       = VK_IMAGE_USAGE_TRANSFER_DST_BIT
-                          | VK_IMAGE_USAGE_SAMPLED_BIT;
-      imgInfo.stages      = VK_PIPELINE_STAGE_TRANSFER_BIT
-                          | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-      imgInfo.access      = VK_ACCESS_TRANSFER_WRITE_BIT
-                          | VK_ACCESS_SHADER_READ_BIT;
-      imgInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
-      imgInfo.layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-      
-      m_gammaTexture = m_device->createImage(
-        imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-      DxvkImageViewCreateInfo viewInfo;
-      viewInfo.type       = VK_IMAGE_VIEW_TYPE_1D;
-      viewInfo.format     = VK_FORMAT_R16G16B16A16_UNORM;
-      viewInfo.usage      = VK_IMAGE_USAGE_SAMPLED_BIT;
-      viewInfo.aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
-      viewInfo.minLevel   = 0;
-      viewInfo.numLevels  = 1;
-      viewInfo.minLayer   = 0;
-      viewInfo.numLayers  = 1;
-      
-      m_gammaTextureView = m_device->createImageView(m_gammaTexture, viewInfo);
-    }
+    // Always create a new texture since queued presents may
+    // still read the old one. They keep it alive via their
+    // reference to the view, so it is never written twice.
+    DxvkImageCreateInfo imgInfo;
+    imgInfo.type        = VK_IMAGE_TYPE_1D;
+    imgInfo.format      = VK_FORMAT_R16G16B16A16_UNORM;
+    imgInfo.flags       = 0;
+    imgInfo.sampleCount = VK_SAMPLE_COUNT_1_BIT;
+    imgInfo.extent      = { NumControlPoints, 1, 1 };
+    imgInfo.numLayers   = 1;
+    imgInfo.mipLevels   = 1;
+    imgInfo.usage       = VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                        | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imgInfo.stages      = VK_PIPELINE_STAGE_TRANSFER_BIT
+                        | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    imgInfo.access      = VK_ACCESS_TRANSFER_WRITE_BIT
+                        | VK_ACCESS_SHADER_READ_BIT;
+    imgInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+    imgInfo.layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    
+    m_gammaTexture = m_device->createImage(
+      imgInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    DxvkImageViewCreateInfo viewInfo;
+    viewInfo.type       = VK_IMAGE_VIEW_TYPE_1D;
+    viewInfo.format     = VK_FORMAT_R16G16B16A16_UNORM;
+    viewInfo.usage      = VK_IMAGE_USAGE_SAMPLED_BIT;
+    viewInfo.aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.minLevel   = 0;
+    viewInfo.numLevels  = 1;
+    viewInfo.minLayer   = 0;
+    viewInfo.numLayers  = 1;
+    
+    m_gammaTextureView = m_device->createImageView(m_gammaTexture, viewInfo);
 
     m_context->beginRecording(
       m_device->createCommandList());
@@ -731,4 +907,19 @@ namespace dxvk {
     return option > 0 ? uint32_t(option) : uint32_t(Preferred);
   }
 
+
+  uint32_t D3D11SwapChain::PickPresentQueueSize() {
+    // The application only has to wait for the present
+    // thread if it is more than one frame latency behind
+    UINT frameLatency = 0;
+    m_dxgiDevice->GetMaximumFrameLatency(&frameLatency);
+
+    int32_t option = m_parent->GetOptions()->maxFrameLatency;
+
+    if (option > 0 && uint32_t(option) < frameLatency)
+      frameLatency = uint32_t(option);
+
+    return std::max(frameLatency, 1u);
+  }
+
 }
\ No newline at end of file
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
 #include "d3d11_texture.h"
 
+#include "../util/thread.h"
+#include "../util/util_fps_limiter.h"
+
 #include "../dxvk/hud/dxvk_hud.h"
 
 namespace dxvk {
@@ -20,6 +27,23 @@ namespace dxvk {
     uint16_t R, G, B, A;
   };
 
+  /**
+   * \brief Queued present operation
+   * 
+   * Stores everything the present thread needs in
+   * order to acquire a swap chain image, blit the
+   * back buffer contents to it and present it.
+   */
+  struct D3D11PresentRequest {
+    uint32_t                imageId;
+    uint32_t                syncInterval;
+    bool                    vsync;
+    bool                    recreate;
+    int64_t                 pacingError;
+    Rc<DxvkImageView>       gammaView;
+    DxvkEventRevision       syncEvent;
+  };
+
   class D3D11SwapChain : public ComObject<IDXGIVkSwapChain> {
 
   public:
@@ -87,6 +111,10 @@ namespace dxvk {
 
     Rc<DxvkDevice>          m_device;
     Rc<DxvkContext>         m_context;
+    Rc<DxvkContext>         m_presentContext;
+
+    DxvkBarrierSet                m_presentBarriers;
+    std::vector<Rc<DxvkResource>> m_presentResources;
 
     Rc<vk::Presenter>       m_presenter;
 
@@ -101,8 +129,9 @@ namespace dxvk {
     Rc<DxvkImageView>       m_gammaTextureView;
 
     Rc<DxvkImage>           m_swapImage;
-    Rc<DxvkImage>           m_swapImageResolve;
-    Rc<DxvkImageView>       m_swapImageView;
+
+    std::vector<Rc<DxvkImage>>     m_presentImages;
+    std::vector<Rc<DxvkImageView>> m_presentImageViews;
 
     Rc<hud::Hud>            m_hud;
 
@@ -120,8 +149,31 @@ namespace dxvk {
     bool                    m_dirty = true;
     bool                    m_vsync = true;
 
+    uint32_t                m_presentFrameId = 0;
+    bool                    m_presentStopped = false;
+
+    FpsLimiter              m_fpsLimiter;
+
+    std::array<Rc<DxvkEvent>, 16> m_frameEvents;
+
+    std::mutex                      m_presentMutex;
+    std::condition_variable         m_presentCondOnAdd;
+    std::condition_variable         m_presentCondOnTake;
+    std::queue<D3D11PresentRequest> m_presentQueue;
+    dxvk::thread                    m_presentThread;
+
     void PresentImage(UINT SyncInterval);
 
+    void PresentThread();
+
+    void ExecutePresent(
+      const D3D11PresentRequest&      Request);
+
+    void AcquirePresentImage(
+      const Rc<DxvkImage>&            Image);
+
+    void SynchronizePresent();
+
     void FlushImmediateContext();
     
     void RecreateSwapChain(
@@ -133,6 +185,8 @@ namespace dxvk {
 
     void CreateBackBuffer();
 
+    void CreatePresentImages();
+
     void CreateGammaTexture(
             UINT                NumControlPoints,
       const D3D11_VK_GAMMA_CP*  pControlPoints);
@@ -156,6 +210,8 @@ namespace dxvk {
     uint32_t PickImageCount(
             UINT                      Preferred);
     
+    uint32_t PickPresentQueueSize();
+    
   };
 
 }
\ No newline at end of file
@@ -147,6 +147,7 @@ namespace dxvk {
     // should in no way affect the default image layout
     imageInfo.usage |= EnableMetaCopyUsage(imageInfo.format, imageInfo.tiling);
     imageInfo.usage |= EnableMetaPackUsage(imageInfo.format, m_desc.CPUAccessFlags);
+    imageInfo.usage |= EnableMetaMipGenUsage(&imageInfo);
     
     // Check if we can actually create the image
     if (!CheckImageSupport(&imageInfo, imageInfo.tiling)) {
@@ -374,6 +375,24 @@ namespace dxvk {
   }
 
   
+  VkImageUsageFlags D3D11CommonTexture::EnableMetaMipGenUsage(
+    const DxvkImageCreateInfo*  pImageInfo) const {
+    if (!(m_desc.MiscFlags & D3D11_RESOURCE_MISC_GENERATE_MIPS)
+     || pImageInfo->mipLevels <= 1)
+      return 0;
+    
+    // Only enable storage access if DxvkContext will
+    // actually take the compute path for this image
+    Rc<DxvkDevice> device = m_device->GetDXVKDevice();
+    
+    bool useCompute = DxvkMetaMipGenCompute::isSupported(
+      device.ptr(), *pImageInfo, pImageInfo->format,
+      pImageInfo->extent, pImageInfo->mipLevels);
+    
+    return useCompute ? VK_IMAGE_USAGE_STORAGE_BIT : 0;
+  }
+
+  
   D3D11_COMMON_TEXTURE_MAP_MODE D3D11CommonTexture::DetermineMapMode(
     const DxvkImageCreateInfo*  pImageInfo) const {
     // Don't map an image unless the application requests it
@@ -216,6 +216,9 @@ namespace dxvk {
             VkFormat              Format,
             UINT                  CpuAccess) const;
     
+    VkImageUsageFlags EnableMetaMipGenUsage(
+      const DxvkImageCreateInfo*  pImageInfo) const;
+    
     D3D11_COMMON_TEXTURE_MAP_MODE DetermineMapMode(
       const DxvkImageCreateInfo*  pImageInfo) const;
     
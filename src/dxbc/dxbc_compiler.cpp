@@ -1534,21 +1534,31 @@ namespace dxvk {
           src.at(0).id, src.at(1).id);
         break;
         
-      case DxbcOpcode::Div:
+      case DxbcOpcode::Div: {
         dst.id = m_module.opFDiv(typeId,
           src.at(0).id, src.at(1).id);
         
-        if (m_moduleInfo.options.strictDivision) {
-          uint32_t boolType = dst.type.ccount > 1
-            ? m_module.defVectorType(m_module.defBoolType(), dst.type.ccount)
-            : m_module.defBoolType();
-          
-          dst.id = m_module.opSelect(typeId,
-            m_module.opFOrdNotEqual(boolType, src.at(1).id,
-              emitBuildConstVecf32(0.0f, 0.0f, 0.0f, 0.0f, ins.dst[0].mask).id),
-            dst.id, src.at(0).id);
+        // Sm4-compliant division by zero is selected at pipeline
+        // compile time, so that the select gets optimized away
+        // by the driver if the behaviour is not enabled.
+        uint32_t boolType = dst.type.ccount > 1
+          ? m_module.defVectorType(m_module.defBoolType(), dst.type.ccount)
+          : m_module.defBoolType();
+        
+        uint32_t strictId = getSpecConstant(DxvkSpecConstantId::StrictDivision).id;
+        
+        if (dst.type.ccount > 1) {
+          std::array<uint32_t, 4> strictIds = {{ strictId, strictId, strictId, strictId }};
+          strictId = m_module.opCompositeConstruct(boolType, dst.type.ccount, strictIds.data());
         }
-        break;
+        
+        uint32_t condId = m_module.opLogicalOr(boolType,
+          m_module.opFOrdNotEqual(boolType, src.at(1).id,
+            emitBuildConstVecf32(0.0f, 0.0f, 0.0f, 0.0f, ins.dst[0].mask).id),
+          m_module.opLogicalNot(boolType, strictId));
+        
+        dst.id = m_module.opSelect(typeId, condId, dst.id, src.at(0).id);
+      } break;
 
       case DxbcOpcode::DDiv:
         dst.id = m_module.opFDiv(typeId,
@@ -5371,9 +5381,9 @@ namespace dxvk {
     
     value.type.ctype  = info.ctype;
     value.type.ccount = info.ccount;
-    value.id = m_module.specConst32(
-      getVectorTypeId(value.type),
-      info.value);
+    value.id = info.ctype == DxbcScalarType::Bool
+      ? m_module.specConstBool(info.value != 0)
+      : m_module.specConst32(getVectorTypeId(value.type), info.value);
     
     m_module.decorateSpecId(value.id, uint32_t(specId));
     m_module.setDebugName(value.id, info.name);
@@ -5387,7 +5397,9 @@ namespace dxvk {
     static const std::array<DxbcSpecConstant,
       uint32_t(DxvkSpecConstantId::SpecConstantIdMax) -
       uint32_t(DxvkSpecConstantId::SpecConstantIdMin) + 1> s_specConstants = {{
-        { DxbcScalarType::Uint32,   1,   1, "RasterizerSampleCount" },
+        { DxbcScalarType::Uint32,   1,   1, "RasterizerSampleCount"   },
+        { DxbcScalarType::Bool,     1,   0, "StrictDivision"          },
+        { DxbcScalarType::Bool,     1,   0, "ZeroInitWorkgroupMemory" },
     }};
     
     return s_specConstants.at(uint32_t(specId) - uint32_t(DxvkSpecConstantId::SpecConstantIdMin));
@@ -6624,8 +6636,29 @@ namespace dxvk {
   void DxbcCompiler::emitCsFinalize() {
     this->emitMainFunctionBegin();
 
-    if (m_moduleInfo.options.zeroInitWorkgroupMemory)
+    bool hasTgsm = false;
+
+    for (uint32_t i = 0; i < m_gRegs.size(); i++)
+      hasTgsm |= m_gRegs[i].varId != 0;
+
+    if (hasTgsm) {
+      // Whether or not to clear shared memory is decided at
+      // pipeline compile time via a specialization constant
+      DxbcConditional cond;
+      cond.labelIf  = m_module.allocateId();
+      cond.labelEnd = m_module.allocateId();
+
+      uint32_t specId = getSpecConstant(DxvkSpecConstantId::ZeroInitWorkgroupMemory).id;
+
+      m_module.opSelectionMerge(cond.labelEnd, spv::SelectionControlMaskNone);
+      m_module.opBranchConditional(specId, cond.labelIf, cond.labelEnd);
+
+      m_module.opLabel(cond.labelIf);
       this->emitInitWorkgroupMemory();
+      m_module.opBranch(cond.labelEnd);
+
+      m_module.opLabel(cond.labelEnd);
+    }
 
     m_module.opFunctionCall(
       m_module.defVoidType(),
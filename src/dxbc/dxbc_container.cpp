@@ -0,0 +1,88 @@
+#include "dxbc_container.h"
+
+namespace dxvk {
+
+  DxbcContainerView::DxbcContainerView(
+    const void*             data,
+          size_t            size)
+  : m_reader(reinterpret_cast<const char*>(data), size) {
+    // The header layout matches the one parsed by DxbcHeader,
+    // but we only need to validate it and read the chunk count
+    DxbcReader reader = m_reader;
+
+    if (reader.readTag() != "DXBC")
+      throw DxvkError("DxbcContainerView: Invalid fourcc, expected 'DXBC'");
+
+    reader.skip(4 * sizeof(uint32_t)); // Check sum
+    reader.skip(1 * sizeof(uint32_t)); // Constant 1
+    reader.skip(1 * sizeof(uint32_t)); // Bytecode length
+
+    m_chunkCount = reader.readu32();
+
+    // Make sure that the chunk offset table is
+    // valid so that we don't have to check later
+    reader.skip(m_chunkCount * sizeof(uint32_t));
+  }
+
+
+  DxbcContainerView::~DxbcContainerView() {
+
+  }
+
+
+  DxbcTag DxbcContainerView::chunkTag(
+          uint32_t          chunkId) const {
+    return m_reader.clone(this->chunkOffset(chunkId)).readTag();
+  }
+
+
+  DxbcReader DxbcContainerView::chunkReader(
+          uint32_t          chunkId) const {
+    DxbcReader reader = m_reader.clone(this->chunkOffset(chunkId));
+    reader.skip(4);
+
+    // The chunk length does not include the eight bytes
+    // that are consumed by the FourCC and length entry
+    uint32_t chunkLength = reader.readu32();
+    return reader.clone(8).resize(chunkLength);
+  }
+
+
+  bool DxbcContainerView::findChunk(
+    const DxbcTag&          tag,
+          uint32_t&         chunkId) const {
+    for (uint32_t i = 0; i < m_chunkCount; i++) {
+      if (this->chunkTag(i) == tag) {
+        chunkId = i;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+
+  Rc<DxbcIsgn> DxbcContainerView::isgn() const {
+    Rc<DxbcIsgn> result;
+
+    for (uint32_t i = 0; i < m_chunkCount; i++) {
+      DxbcTag tag = this->chunkTag(i);
+
+      if (tag == "ISGN" || tag == "ISG1")
+        result = new DxbcIsgn(this->chunkReader(i), tag);
+    }
+
+    return result;
+  }
+
+
+  uint32_t DxbcContainerView::chunkOffset(
+          uint32_t          chunkId) const {
+    if (chunkId >= m_chunkCount)
+      throw DxvkError("DxbcContainerView: Invalid chunk index");
+
+    // Chunk offsets are stored right after the header
+    return m_reader.clone(32 + chunkId * sizeof(uint32_t)).readu32();
+  }
+
+}
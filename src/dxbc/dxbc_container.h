@@ -0,0 +1,88 @@
+#pragma once
+
+#include "dxbc_chunk_isgn.h"
+#include "dxbc_common.h"
+#include "dxbc_reader.h"
+#include "dxbc_tag.h"
+
+namespace dxvk {
+
+  /**
+   * \brief DXBC container view
+   *
+   * Non-owning view of DXBC byte code that can look up
+   * chunks and parse the input signature without parsing
+   * the instruction stream. Does not allocate any memory
+   * itself, and the byte code must outlive the view.
+   */
+  class DxbcContainerView {
+
+  public:
+
+    DxbcContainerView(
+      const void*             data,
+            size_t            size);
+
+    ~DxbcContainerView();
+
+    /**
+     * \brief Number of chunks
+     * \returns Chunk count
+     */
+    uint32_t numChunks() const {
+      return m_chunkCount;
+    }
+
+    /**
+     * \brief Retrieves chunk tag
+     *
+     * \param [in] chunkId Chunk index
+     * \returns Four-character code of the chunk
+     */
+    DxbcTag chunkTag(
+            uint32_t          chunkId) const;
+
+    /**
+     * \brief Creates a reader for a chunk
+     *
+     * The reader only covers the chunk payload, i.e.
+     * it does not include the tag and chunk length.
+     * \param [in] chunkId Chunk index
+     * \returns Reader for the chunk data
+     */
+    DxbcReader chunkReader(
+            uint32_t          chunkId) const;
+
+    /**
+     * \brief Finds a chunk by tag
+     *
+     * \param [in] tag Chunk tag to look for
+     * \param [out] chunkId Index of the chunk
+     * \returns \c true if the chunk was found
+     */
+    bool findChunk(
+      const DxbcTag&          tag,
+            uint32_t&         chunkId) const;
+
+    /**
+     * \brief Parses the input signature
+     *
+     * Only parses the ISGN or ISG1 chunk. If there are
+     * multiple, the last one is used, like \ref DxbcModule
+     * does when parsing the full shader.
+     * \returns Input signature, or \c nullptr
+     *    if the shader has no input signature
+     */
+    Rc<DxbcIsgn> isgn() const;
+
+  private:
+
+    DxbcReader  m_reader;
+    uint32_t    m_chunkCount = 0;
+
+    uint32_t chunkOffset(
+            uint32_t          chunkId) const;
+
+  };
+
+}
@@ -28,12 +28,6 @@ namespace dxvk {
     /// Use SDiv instead of SHR to converte byte offsets to
     /// dword offsets. Fixes RE2 and DMC5 on Nvidia drivers.
     bool useSdivForBufferIndex = false;
-
-    /// Enables sm4-compliant division-by-zero behaviour
-    bool strictDivision = false;
-
-    /// Clear thread-group shared memory to zero
-    bool zeroInitWorkgroupMemory = false;
   };
   
 }
\ No newline at end of file
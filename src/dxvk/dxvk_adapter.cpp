@@ -104,6 +104,19 @@ namespace dxvk {
   }
   
   
+  uint32_t DxvkAdapter::transferQueueFamily() const {
+    for (uint32_t i = 0; i < m_queueFamilies.size(); i++) {
+      VkQueueFlags flags = m_queueFamilies[i].queueFlags;
+      
+      if ((flags & VK_QUEUE_TRANSFER_BIT)
+       && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+        return i;
+    }
+    
+    return this->graphicsQueueFamily();
+  }
+  
+  
   bool DxvkAdapter::checkFeatureSupport(const DxvkDeviceFeatures& required) const {
     return (m_deviceFeatures.core.features.robustBufferAccess
                 || !required.core.features.robustBufferAccess)
@@ -215,6 +228,8 @@ namespace dxvk {
                 || !required.core.features.variableMultisampleRate)
         && (m_deviceFeatures.core.features.inheritedQueries
                 || !required.core.features.inheritedQueries)
+        && (m_deviceFeatures.extConditionalRendering.conditionalRendering
+                || !required.extConditionalRendering.conditionalRendering)
         && (m_deviceFeatures.extDepthClipEnable.depthClipEnable
                 || !required.extDepthClipEnable.depthClipEnable)
         && (m_deviceFeatures.extMemoryPriority.memoryPriority
@@ -236,8 +251,9 @@ namespace dxvk {
   Rc<DxvkDevice> DxvkAdapter::createDevice(std::string clientApi, DxvkDeviceFeatures enabledFeatures) {
     DxvkDeviceExtensions devExtensions;
 
-    std::array<DxvkExt*, 16> devExtensionList = {{
+    std::array<DxvkExt*, 17> devExtensionList = {{
       &devExtensions.amdMemoryOverallocationBehaviour,
+      &devExtensions.extConditionalRendering,
       &devExtensions.extDepthClipEnable,
       &devExtensions.extMemoryPriority,
       &devExtensions.extShaderViewportIndexLayer,
@@ -274,6 +290,12 @@ namespace dxvk {
     enabledFeatures.core.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
     enabledFeatures.core.pNext = nullptr;
 
+    if (devExtensions.extConditionalRendering) {
+      enabledFeatures.extConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+      enabledFeatures.extConditionalRendering.pNext = enabledFeatures.core.pNext;
+      enabledFeatures.core.pNext = &enabledFeatures.extConditionalRendering;
+    }
+
     if (devExtensions.extDepthClipEnable) {
       enabledFeatures.extDepthClipEnable.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEPTH_CLIP_ENABLE_FEATURES_EXT;
       enabledFeatures.extDepthClipEnable.pNext = enabledFeatures.core.pNext;
@@ -304,12 +326,14 @@ namespace dxvk {
     overallocInfo.pNext = nullptr;
     overallocInfo.overallocationBehavior = VK_MEMORY_OVERALLOCATION_BEHAVIOR_ALLOWED_AMD;
     
-    // Create one single queue for graphics and present
+    // Create one single queue for graphics and present, plus
+    // a transfer queue if there is a dedicated queue family
     float queuePriority = 1.0f;
     std::vector<VkDeviceQueueCreateInfo> queueInfos;
     
     uint32_t gIndex = this->graphicsQueueFamily();
     uint32_t pIndex = this->presentQueueFamily();
+    uint32_t tIndex = this->transferQueueFamily();
     
     VkDeviceQueueCreateInfo graphicsQueue;
     graphicsQueue.sType             = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -325,6 +349,12 @@ namespace dxvk {
       presentQueue.queueFamilyIndex        = pIndex;
       queueInfos.push_back(presentQueue);
     }
+    
+    if (tIndex != gIndex && tIndex != pIndex) {
+      VkDeviceQueueCreateInfo transferQueue = graphicsQueue;
+      transferQueue.queueFamilyIndex        = tIndex;
+      queueInfos.push_back(transferQueue);
+    }
 
     VkDeviceCreateInfo info;
     info.sType                      = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -478,6 +508,11 @@ namespace dxvk {
     m_deviceFeatures.core.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
     m_deviceFeatures.core.pNext = nullptr;
 
+    if (m_deviceExtensions.supports(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME)) {
+      m_deviceFeatures.extConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+      m_deviceFeatures.extConditionalRendering.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extConditionalRendering);
+    }
+
     if (m_deviceExtensions.supports(VK_EXT_DEPTH_CLIP_ENABLE_EXTENSION_NAME)) {
       m_deviceFeatures.extDepthClipEnable.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEPTH_CLIP_ENABLE_FEATURES_EXT;
       m_deviceFeatures.extDepthClipEnable.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extDepthClipEnable);
@@ -173,6 +173,16 @@ namespace dxvk {
      */
     uint32_t presentQueueFamily() const;
     
+    /**
+     * \brief Transfer queue family index
+     * 
+     * Returns a queue family that only supports transfer
+     * operations if there is one, which usually maps to a
+     * dedicated DMA engine, or the graphics queue family.
+     * \returns Transfer queue family index
+     */
+    uint32_t transferQueueFamily() const;
+    
     /**
      * \brief Tests whether all required features are supported
      * 
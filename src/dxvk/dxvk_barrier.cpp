@@ -88,6 +88,85 @@ namespace dxvk {
     m_srcAccess |= srcAccess;
     m_dstAccess |= dstAccess;
   }
+
+
+  void DxvkBarrierSet::releaseBuffer(
+          DxvkBarrierSet&           acquire,
+    const DxvkBufferSliceHandle&    bufSlice,
+          uint32_t                  srcQueue,
+          VkPipelineStageFlags      srcStages,
+          VkAccessFlags             srcAccess,
+          uint32_t                  dstQueue,
+          VkPipelineStageFlags      dstStages,
+          VkAccessFlags             dstAccess) {
+    // The release barrier only makes the source writes
+    // available, and the acquire barrier makes them
+    // visible to the destination stages.
+    VkBufferMemoryBarrier barrier;
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext               = nullptr;
+    barrier.srcAccessMask       = srcAccess;
+    barrier.dstAccessMask       = 0;
+    barrier.srcQueueFamilyIndex = srcQueue;
+    barrier.dstQueueFamilyIndex = dstQueue;
+    barrier.buffer              = bufSlice.handle;
+    barrier.offset              = bufSlice.offset;
+    barrier.size                = bufSlice.length;
+    
+    m_srcStages |= srcStages;
+    m_dstStages |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    m_bufBarriers.push_back(barrier);
+    m_bufSlices.push_back({ bufSlice, DxvkAccess::Write });
+    
+    barrier.srcAccessMask       = 0;
+    barrier.dstAccessMask       = dstAccess;
+    
+    acquire.m_srcStages |= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    acquire.m_dstStages |= dstStages;
+    acquire.m_bufBarriers.push_back(barrier);
+    acquire.m_bufSlices.push_back({ bufSlice, DxvkAccess::Write });
+  }
+
+
+  void DxvkBarrierSet::releaseImage(
+          DxvkBarrierSet&           acquire,
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceRange&  subresources,
+          uint32_t                  srcQueue,
+          VkImageLayout             srcLayout,
+          VkPipelineStageFlags      srcStages,
+          VkAccessFlags             srcAccess,
+          uint32_t                  dstQueue,
+          VkImageLayout             dstLayout,
+          VkPipelineStageFlags      dstStages,
+          VkAccessFlags             dstAccess) {
+    // Both barriers must specify the same layout transition
+    VkImageMemoryBarrier barrier;
+    barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext                       = nullptr;
+    barrier.srcAccessMask               = srcAccess;
+    barrier.dstAccessMask               = 0;
+    barrier.oldLayout                   = srcLayout;
+    barrier.newLayout                   = dstLayout;
+    barrier.srcQueueFamilyIndex         = srcQueue;
+    barrier.dstQueueFamilyIndex         = dstQueue;
+    barrier.image                       = image->handle();
+    barrier.subresourceRange            = subresources;
+    barrier.subresourceRange.aspectMask = image->formatInfo()->aspectMask;
+    
+    m_srcStages |= srcStages;
+    m_dstStages |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    m_imgBarriers.push_back(barrier);
+    m_imgSlices.push_back({ image.ptr(), subresources, DxvkAccess::Write });
+    
+    barrier.srcAccessMask               = 0;
+    barrier.dstAccessMask               = dstAccess;
+    
+    acquire.m_srcStages |= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    acquire.m_dstStages |= dstStages;
+    acquire.m_imgBarriers.push_back(barrier);
+    acquire.m_imgSlices.push_back({ image.ptr(), subresources, DxvkAccess::Write });
+  }
   
   
   bool DxvkBarrierSet::isBufferDirty(
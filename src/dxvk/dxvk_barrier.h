@@ -43,6 +43,50 @@ namespace dxvk {
             VkPipelineStageFlags      dstStages,
             VkAccessFlags             dstAccess);
     
+    /**
+     * \brief Transfers buffer ownership to another queue
+     * 
+     * Adds the release barrier to this barrier set and
+     * the matching acquire barrier to \c acquire, which
+     * must be recorded on the destination queue.
+     * \param [in] acquire Barrier set for the acquire
+     * \param [in] bufSlice Buffer slice to transfer
+     * \param [in] srcQueue Source queue family
+     * \param [in] srcStages Source pipeline stages
+     * \param [in] srcAccess Source access flags
+     * \param [in] dstQueue Destination queue family
+     * \param [in] dstStages Destination pipeline stages
+     * \param [in] dstAccess Destination access flags
+     */
+    void releaseBuffer(
+            DxvkBarrierSet&           acquire,
+      const DxvkBufferSliceHandle&    bufSlice,
+            uint32_t                  srcQueue,
+            VkPipelineStageFlags      srcStages,
+            VkAccessFlags             srcAccess,
+            uint32_t                  dstQueue,
+            VkPipelineStageFlags      dstStages,
+            VkAccessFlags             dstAccess);
+    
+    /**
+     * \brief Transfers image ownership to another queue
+     * 
+     * Same as \ref releaseBuffer, but also performs a
+     * layout transition as part of the ownership transfer.
+     */
+    void releaseImage(
+            DxvkBarrierSet&           acquire,
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceRange&  subresources,
+            uint32_t                  srcQueue,
+            VkImageLayout             srcLayout,
+            VkPipelineStageFlags      srcStages,
+            VkAccessFlags             srcAccess,
+            uint32_t                  dstQueue,
+            VkImageLayout             dstLayout,
+            VkPipelineStageFlags      dstStages,
+            VkAccessFlags             dstAccess);
+    
     bool isBufferDirty(
       const DxvkBufferSliceHandle&    bufSlice,
             DxvkAccessFlags           bufAccess);
@@ -1,4 +1,5 @@
 #include "dxvk_buffer.h"
+#include "dxvk_buffer_arena.h"
 #include "dxvk_device.h"
 
 namespace dxvk {
@@ -7,16 +8,25 @@ namespace dxvk {
           DxvkDevice*           device,
     const DxvkBufferCreateInfo& createInfo,
           DxvkMemoryAllocator&  memAlloc,
+          DxvkBufferArena*      arena,
           VkMemoryPropertyFlags memFlags)
   : m_device        (device),
     m_info          (createInfo),
     m_memAlloc      (&memAlloc),
+    m_arena         (arena),
     m_memFlags      (memFlags) {
     // Align slices to 256 bytes, which guarantees that
     // we don't violate any Vulkan alignment requirements
     m_physSliceLength = createInfo.size;
     m_physSliceStride = align(createInfo.size, 256);
     
+    // Small buffers take all their slices from the shared
+    // arena, including the initial one, and own no memory
+    if (m_arena != nullptr) {
+      m_physSlice = allocArenaSlice();
+      return;
+    }
+    
     // Allocate a single buffer slice
     m_buffer = allocBuffer(1);
 
@@ -28,14 +38,79 @@ namespace dxvk {
 
 
   DxvkBuffer::~DxvkBuffer() {
+    // The buffer is no longer in use by the GPU at this
+    // point, so the current slice can be freed right away
+    if (m_arena != nullptr) {
+      freeArenaSlice(m_physSlice);
+      return;
+    }
+    
+    m_device->unregisterTrimBuffer(this);
+    
+    m_memAlloc->removeSpareMemory(m_physSliceStride
+      * (m_freeSlices.size() + m_nextSlices.size()));
+    
     auto vkd = m_device->vkd();
 
     for (const auto& buffer : m_buffers)
-      vkd->vkDestroyBuffer(vkd->device(), buffer.buffer, nullptr);
+      vkd->vkDestroyBuffer(vkd->device(), buffer.handle.buffer, nullptr);
     vkd->vkDestroyBuffer(vkd->device(), m_buffer.buffer, nullptr);
   }
   
   
+  bool DxvkBuffer::trim() {
+    std::unique_lock<sync::Spinlock> freeLock(m_freeMutex);
+    std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
+    
+    // Let the usage estimate decay slowly, so that we do not
+    // release memory between two bursts of discards that are
+    // a few frames apart, and keep twice as many slices as
+    // were needed at once during the last couple of periods.
+    m_sliceUsage     = std::max(m_peakSliceCount, m_sliceUsage - m_sliceUsage / 4);
+    m_peakSliceCount = m_usedSliceCount.load();
+    
+    VkDeviceSize targetCapacity = 2 * m_sliceUsage;
+    VkDeviceSize prevCapacity   = m_sliceCapacity;
+    
+    auto vkd = m_device->vkd();
+    
+    // Backing buffers grow geometrically, so releasing them in
+    // reverse order frees up the largest ones first. We can
+    // only release a buffer if none of its slices are in use.
+    while (!m_buffers.empty()) {
+      const SliceBuffer& buffer = m_buffers.back();
+      
+      if (m_sliceCapacity - buffer.sliceCount < targetCapacity)
+        break;
+      
+      auto isFromBuffer = [&buffer] (const DxvkBufferSliceHandle& slice) {
+        return slice.handle == buffer.handle.buffer;
+      };
+      
+      size_t freeCount = std::count_if(m_freeSlices.begin(), m_freeSlices.end(), isFromBuffer)
+                       + std::count_if(m_nextSlices.begin(), m_nextSlices.end(), isFromBuffer);
+      
+      if (freeCount != buffer.sliceCount)
+        break;
+      
+      m_freeSlices.erase(std::remove_if(m_freeSlices.begin(), m_freeSlices.end(), isFromBuffer), m_freeSlices.end());
+      m_nextSlices.erase(std::remove_if(m_nextSlices.begin(), m_nextSlices.end(), isFromBuffer), m_nextSlices.end());
+      
+      m_memAlloc->removeSpareMemory(m_physSliceStride * buffer.sliceCount);
+      m_sliceCapacity -= buffer.sliceCount;
+      
+      vkd->vkDestroyBuffer(vkd->device(), buffer.handle.buffer, nullptr);
+      m_buffers.pop_back();
+    }
+    
+    // Restart geometric growth from the current capacity
+    if (m_sliceCapacity != prevCapacity)
+      m_physSliceCount = std::max<VkDeviceSize>(m_sliceCapacity + 1, 2);
+    
+    return !m_buffers.empty();
+  }
+  
+  
   DxvkBufferHandle DxvkBuffer::allocBuffer(VkDeviceSize sliceCount) const {
     auto vkd = m_device->vkd();
 
@@ -102,6 +177,28 @@ namespace dxvk {
     
     return handle;
   }
+  
+  
+  DxvkBufferSliceHandle DxvkBuffer::allocArenaSlice() {
+    return m_arena->allocSlice(m_info, m_memFlags);
+  }
+  
+  
+  void DxvkBuffer::registerForTrim() {
+    // Buffer views are cached per physical slice, so
+    // we must never release slices of texel buffers
+    if (m_info.usage & (VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT
+                      | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT))
+      return;
+    
+    m_device->registerTrimBuffer(this);
+  }
+  
+  
+  void DxvkBuffer::freeArenaSlice(
+    const DxvkBufferSliceHandle& slice) {
+    m_arena->freeSlice(slice);
+  }
 
 
   
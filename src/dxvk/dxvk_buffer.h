@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
@@ -11,6 +12,8 @@
 
 namespace dxvk {
 
+  class DxvkBufferArena;
+
   /**
    * \brief Buffer create info
    * 
@@ -30,6 +33,11 @@ namespace dxvk {
     
     /// Allowed access patterns
     VkAccessFlags access;
+    
+    /// Whether the buffer gets renamed frequently,
+    /// e.g. when it is mapped with \c DISCARD. Only
+    /// such buffers use the shared buffer arena.
+    bool discardable = false;
   };
   
   
@@ -107,6 +115,7 @@ namespace dxvk {
             DxvkDevice*           device,
       const DxvkBufferCreateInfo& createInfo,
             DxvkMemoryAllocator&  memAlloc,
+            DxvkBufferArena*      arena,
             VkMemoryPropertyFlags memFlags);
     
     ~DxvkBuffer();
@@ -233,36 +242,57 @@ namespace dxvk {
      * \returns The new buffer slice
      */
     DxvkBufferSliceHandle allocSlice() {
-      std::unique_lock<sync::Spinlock> freeLock(m_freeMutex);
+      if (m_arena != nullptr)
+        return allocArenaSlice();
       
-      // If no slices are available, swap the two free lists.
-      if (unlikely(m_freeSlices.size() == 0)) {
-        std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
-        std::swap(m_freeSlices, m_nextSlices);
-      }
-
-      // If there are still no slices available, create a new
-      // backing buffer and add all slices to the free list.
-      if (unlikely(m_freeSlices.size() == 0)) {
-        std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
-        DxvkBufferHandle handle = allocBuffer(m_physSliceCount);
+      DxvkBufferSliceHandle result;
+      bool grown = false;
+      
+      { std::unique_lock<sync::Spinlock> freeLock(m_freeMutex);
         
-        for (uint32_t i = 0; i < m_physSliceCount; i++) {
-          DxvkBufferSliceHandle slice;
-          slice.handle = handle.buffer;
-          slice.offset = m_physSliceStride * i;
-          slice.length = m_physSliceLength;
-          slice.mapPtr = handle.memory.mapPtr(slice.offset);
-          m_freeSlices.push_back(slice);
+        // If no slices are available, swap the two free lists.
+        if (unlikely(m_freeSlices.size() == 0)) {
+          std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
+          std::swap(m_freeSlices, m_nextSlices);
         }
         
-        m_buffers.push_back(std::move(handle));
-        m_physSliceCount *= 2;
+        // If there are still no slices available, create a new
+        // backing buffer and add all slices to the free list.
+        if (unlikely(m_freeSlices.size() == 0)) {
+          std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
+          DxvkBufferHandle handle = allocBuffer(m_physSliceCount);
+          
+          for (uint32_t i = 0; i < m_physSliceCount; i++) {
+            DxvkBufferSliceHandle slice;
+            slice.handle = handle.buffer;
+            slice.offset = m_physSliceStride * i;
+            slice.length = m_physSliceLength;
+            slice.mapPtr = handle.memory.mapPtr(slice.offset);
+            m_freeSlices.push_back(slice);
+          }
+          
+          m_memAlloc->addSpareMemory(m_physSliceStride * m_physSliceCount);
+          
+          m_buffers.push_back({ std::move(handle), m_physSliceCount });
+          m_sliceCapacity  += m_physSliceCount;
+          m_physSliceCount *= 2;
+          grown = true;
+        }
+        
+        // Take the first slice from the queue
+        result = m_freeSlices.back();
+        m_freeSlices.pop_back();
+        
+        m_memAlloc->removeSpareMemory(m_physSliceStride);
+        
+        // Track peak usage so that unused backing
+        // buffers can be released later on
+        m_peakSliceCount = std::max(m_peakSliceCount, ++m_usedSliceCount);
       }
       
-      // Take the first slice from the queue
-      DxvkBufferSliceHandle result = m_freeSlices.back();
-      m_freeSlices.pop_back();
+      if (unlikely(grown))
+        this->registerForTrim();
+      
       return result;
     }
     
@@ -275,16 +305,38 @@ namespace dxvk {
      * \param [in] slice The buffer slice to free
      */
     void freeSlice(const DxvkBufferSliceHandle& slice) {
+      if (m_arena != nullptr) {
+        freeArenaSlice(slice);
+        return;
+      }
+      
       // Add slice to a separate free list to reduce lock contention.
       std::unique_lock<sync::Spinlock> swapLock(m_swapMutex);
       m_nextSlices.push_back(slice);
+      
+      m_memAlloc->addSpareMemory(m_physSliceStride);
+      m_usedSliceCount -= 1;
     }
     
+    /**
+     * \brief Releases unused backing buffers
+     * 
+     * Compares the number of slices needed recently with
+     * the number of slices available, and destroys backing
+     * buffers that are not needed anymore and currently do
+     * not hold any slices in use. Called periodically by
+     * the device.
+     * \returns \c true if the buffer still holds backing
+     *    buffers that may be released in the future
+     */
+    bool trim();
+    
   private:
 
     DxvkDevice*             m_device;
     DxvkBufferCreateInfo    m_info;
     DxvkMemoryAllocator*    m_memAlloc;
+    DxvkBufferArena*        m_arena;
     VkMemoryPropertyFlags   m_memFlags;
     
     DxvkBufferHandle        m_buffer;
@@ -295,17 +347,35 @@ namespace dxvk {
     sync::Spinlock m_freeMutex;
     sync::Spinlock m_swapMutex;
     
-    std::vector<DxvkBufferHandle>        m_buffers;
+    struct SliceBuffer {
+      DxvkBufferHandle  handle;
+      VkDeviceSize      sliceCount;
+    };
+    
+    std::vector<SliceBuffer>             m_buffers;
     std::vector<DxvkBufferSliceHandle>   m_freeSlices;
     std::vector<DxvkBufferSliceHandle>   m_nextSlices;
     
     VkDeviceSize m_physSliceLength  = 0;
     VkDeviceSize m_physSliceStride  = 0;
     VkDeviceSize m_physSliceCount   = 2;
+    
+    VkDeviceSize m_sliceCapacity    = 1;
+    VkDeviceSize m_peakSliceCount   = 1;
+    VkDeviceSize m_sliceUsage       = 1;
+    
+    std::atomic<VkDeviceSize> m_usedSliceCount = { 1ull };
 
     DxvkBufferHandle allocBuffer(
             VkDeviceSize          sliceCount) const;
     
+    DxvkBufferSliceHandle allocArenaSlice();
+    
+    void registerForTrim();
+    
+    void freeArenaSlice(
+      const DxvkBufferSliceHandle& slice);
+    
   };
   
   
@@ -0,0 +1,151 @@
+#include "dxvk_buffer_arena.h"
+#include "dxvk_device.h"
+
+namespace dxvk {
+
+  DxvkBufferArena::DxvkBufferArena(DxvkDevice* device)
+  : m_device(device) {
+
+  }
+
+
+  DxvkBufferArena::~DxvkBufferArena() {
+
+  }
+
+
+  bool DxvkBufferArena::isEligible(
+    const DxvkBufferCreateInfo&   info,
+          VkMemoryPropertyFlags   memFlags) {
+    if (!info.discardable)
+      return false;
+
+    if (!(memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+      return false;
+
+    if (info.size > MaxSliceSize)
+      return false;
+
+    return !(info.usage & ~ChunkUsage);
+  }
+
+
+  DxvkBufferSliceHandle DxvkBufferArena::allocSlice(
+    const DxvkBufferCreateInfo&   info,
+          VkMemoryPropertyFlags   memFlags) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t poolIndex = this->findPool(memFlags);
+    Pool&  pool      = m_pools[poolIndex];
+
+    VkDeviceSize size = align(info.size, SliceAlign);
+
+    // If the current chunk is full, retire it. It will become
+    // available again once all its slices have been freed.
+    if (pool.current != nullptr && pool.current->offset + size > ChunkSize) {
+      Chunk* chunk = pool.current;
+      chunk->retired = true;
+      pool.current   = nullptr;
+
+      if (chunk->liveCount == 0) {
+        chunk->offset  = 0;
+        chunk->retired = false;
+        pool.idleChunks.push_back(chunk);
+      }
+    }
+
+    if (pool.current == nullptr) {
+      if (!pool.idleChunks.empty()) {
+        pool.current = pool.idleChunks.back();
+        pool.idleChunks.pop_back();
+      } else {
+        pool.current = this->allocChunk(poolIndex);
+      }
+    }
+
+    Chunk* chunk = pool.current;
+
+    DxvkBufferSliceHandle slice = chunk->buffer->getSliceHandle(chunk->offset, info.size);
+
+    chunk->offset    += size;
+    chunk->liveCount += 1;
+    return slice;
+  }
+
+
+  void DxvkBufferArena::freeSlice(
+    const DxvkBufferSliceHandle&  slice) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto entry = m_chunks.find(slice.handle);
+
+    if (entry == m_chunks.end())
+      return;
+
+    Chunk* chunk = entry->second.get();
+    chunk->liveCount -= 1;
+
+    if (chunk->liveCount != 0 || !chunk->retired)
+      return;
+
+    // Keep a small number of idle chunks around so that
+    // we don't reallocate memory every time a chunk runs
+    // dry, and give the rest back to the allocator.
+    Pool& pool = m_pools[chunk->pool];
+
+    if (pool.idleChunks.size() < MaxIdleChunks) {
+      chunk->offset  = 0;
+      chunk->retired = false;
+      pool.idleChunks.push_back(chunk);
+    } else {
+      m_chunks.erase(entry);
+    }
+  }
+
+
+  size_t DxvkBufferArena::findPool(
+          VkMemoryPropertyFlags   memFlags) {
+    // All chunks support every usage that arena buffers
+    // can have, so we only need one pool per memory type
+    for (size_t i = 0; i < m_pools.size(); i++) {
+      if (m_pools[i].memFlags == memFlags)
+        return i;
+    }
+
+    Pool pool;
+    pool.memFlags = memFlags;
+
+    m_pools.push_back(pool);
+    return m_pools.size() - 1;
+  }
+
+
+  DxvkBufferArena::Chunk* DxvkBufferArena::allocChunk(
+          size_t                  pool) {
+    DxvkBufferCreateInfo chunkInfo;
+    chunkInfo.size   = ChunkSize;
+    chunkInfo.usage  = ChunkUsage;
+    chunkInfo.stages = VK_PIPELINE_STAGE_HOST_BIT
+                     | VK_PIPELINE_STAGE_TRANSFER_BIT
+                     | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+                     | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+                     | m_device->getShaderPipelineStages();
+    chunkInfo.access = VK_ACCESS_HOST_READ_BIT
+                     | VK_ACCESS_HOST_WRITE_BIT
+                     | VK_ACCESS_TRANSFER_READ_BIT
+                     | VK_ACCESS_TRANSFER_WRITE_BIT
+                     | VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+                     | VK_ACCESS_INDEX_READ_BIT
+                     | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+                     | VK_ACCESS_UNIFORM_READ_BIT;
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->buffer = m_device->createBuffer(chunkInfo, m_pools[pool].memFlags);
+    chunk->pool   = pool;
+
+    Chunk* result = chunk.get();
+    m_chunks.insert({ chunk->buffer->getSliceHandle().handle, std::move(chunk) });
+    return result;
+  }
+
+}
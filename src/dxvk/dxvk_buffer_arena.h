@@ -0,0 +1,121 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dxvk_buffer.h"
+
+namespace dxvk {
+
+  class DxvkDevice;
+
+  /**
+   * \brief Shared buffer arena
+   *
+   * Device-wide linear allocator for the physical slices
+   * of small host-visible buffers that are discarded many
+   * times per frame. Slices are carved out of large chunks,
+   * so that such buffers do not each own a set of dedicated
+   * backing buffers.
+   *
+   * A chunk is filled linearly and retired once it runs
+   * out of space. Slices are returned when the command
+   * list that last used them has completed execution, and
+   * a retired chunk is reset as soon as all of its slices
+   * have been returned.
+   */
+  class DxvkBufferArena {
+
+  public:
+
+    /// Size of a single arena chunk, in bytes
+    constexpr static VkDeviceSize ChunkSize     = 4ull << 20;
+    /// Largest buffer that will use the arena
+    constexpr static VkDeviceSize MaxSliceSize  = 64ull << 10;
+    /// Slice alignment, same as for dedicated buffers
+    constexpr static VkDeviceSize SliceAlign    = 256;
+    /// Number of idle chunks to keep per pool
+    constexpr static uint32_t     MaxIdleChunks = 2;
+    /// Usage flags of all chunks
+    constexpr static VkBufferUsageFlags ChunkUsage
+      = VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+      | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+      | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+      | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    DxvkBufferArena(DxvkDevice* device);
+    ~DxvkBufferArena();
+
+    /**
+     * \brief Checks whether a buffer can use the arena
+     *
+     * Only small host-visible buffers that are marked as
+     * discardable are eligible, since a single long-lived
+     * slice keeps its entire chunk from being reused. Texel
+     * buffers are excluded since buffer views are cached per
+     * physical slice, and storage buffers since they cannot
+     * be discarded.
+     * \param [in] info Buffer create info
+     * \param [in] memFlags Memory property flags
+     * \returns \c true if slices can be allocated
+     */
+    static bool isEligible(
+      const DxvkBufferCreateInfo&   info,
+            VkMemoryPropertyFlags   memFlags);
+
+    /**
+     * \brief Allocates a buffer slice
+     *
+     * \param [in] info Create info of the virtual buffer
+     * \param [in] memFlags Memory property flags
+     * \returns The new buffer slice
+     */
+    DxvkBufferSliceHandle allocSlice(
+      const DxvkBufferCreateInfo&   info,
+            VkMemoryPropertyFlags   memFlags);
+
+    /**
+     * \brief Frees a buffer slice
+     *
+     * The slice must no longer be in use by the GPU.
+     * \param [in] slice The buffer slice to free
+     */
+    void freeSlice(
+      const DxvkBufferSliceHandle&  slice);
+
+  private:
+
+    struct Chunk {
+      Rc<DxvkBuffer>        buffer;
+      size_t                pool;
+      VkDeviceSize          offset    = 0;
+      uint32_t              liveCount = 0;
+      bool                  retired   = false;
+    };
+
+    struct Pool {
+      VkMemoryPropertyFlags memFlags;
+      Chunk*                current = nullptr;
+      std::vector<Chunk*>   idleChunks;
+    };
+
+    DxvkDevice*             m_device;
+
+    std::mutex              m_mutex;
+    std::vector<Pool>       m_pools;
+
+    std::unordered_map<VkBuffer, std::unique_ptr<Chunk>> m_chunks;
+
+    size_t findPool(
+            VkMemoryPropertyFlags   memFlags);
+
+    Chunk* allocChunk(
+            size_t                  pool);
+
+  };
+
+}
@@ -7,6 +7,7 @@ namespace dxvk {
           DxvkDevice*       device,
           uint32_t          queueFamily)
   : m_vkd           (device->vkd()),
+    m_queueFamily   (queueFamily),
     m_cmdBuffersUsed(0),
     m_descriptorPoolTracker(device),
     m_stagingAlloc  (device) {
@@ -18,6 +19,8 @@ namespace dxvk {
     if (m_vkd->vkCreateFence(m_vkd->device(), &fenceInfo, nullptr, &m_fence) != VK_SUCCESS)
       throw DxvkError("DxvkCommandList: Failed to create fence");
     
+    m_submitFence = m_fence;
+    
     VkCommandPoolCreateInfo poolInfo;
     poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     poolInfo.pNext            = nullptr;
@@ -48,33 +51,37 @@ namespace dxvk {
   }
   
   
-  VkResult DxvkCommandList::submit(
-          VkQueue         queue,
+  VkSubmitInfo DxvkCommandList::prepareSubmit(
           VkSemaphore     waitSemaphore,
           VkSemaphore     wakeSemaphore) {
-    std::array<VkCommandBuffer, 2> cmdBuffers;
     uint32_t cmdBufferCount = 0;
     
     if (m_cmdBuffersUsed.test(DxvkCmdBufferFlag::InitBuffer))
-      cmdBuffers[cmdBufferCount++] = m_initBuffer;
+      m_submitBuffers[cmdBufferCount++] = m_initBuffer;
     if (m_cmdBuffersUsed.test(DxvkCmdBufferFlag::ExecBuffer))
-      cmdBuffers[cmdBufferCount++] = m_execBuffer;
+      m_submitBuffers[cmdBufferCount++] = m_execBuffer;
+    
+    m_submitWaitSemaphores = m_waitSemaphores;
+    
+    if (waitSemaphore != VK_NULL_HANDLE)
+      m_submitWaitSemaphores.push_back(waitSemaphore);
+    
+    m_submitWaitStages.resize(m_submitWaitSemaphores.size(),
+      VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
     
-    const VkPipelineStageFlags waitStageMask
-      = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    m_submitWakeSemaphore = wakeSemaphore;
     
     VkSubmitInfo info;
     info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     info.pNext                = nullptr;
-    info.waitSemaphoreCount   = waitSemaphore == VK_NULL_HANDLE ? 0 : 1;
-    info.pWaitSemaphores      = &waitSemaphore;
-    info.pWaitDstStageMask    = &waitStageMask;
+    info.waitSemaphoreCount   = m_submitWaitSemaphores.size();
+    info.pWaitSemaphores      = m_submitWaitSemaphores.data();
+    info.pWaitDstStageMask    = m_submitWaitStages.data();
     info.commandBufferCount   = cmdBufferCount;
-    info.pCommandBuffers      = cmdBuffers.data();
+    info.pCommandBuffers      = m_submitBuffers.data();
     info.signalSemaphoreCount = wakeSemaphore == VK_NULL_HANDLE ? 0 : 1;
-    info.pSignalSemaphores    = &wakeSemaphore;
-    
-    return m_vkd->vkQueueSubmit(queue, 1, &info, m_fence);
+    info.pSignalSemaphores    = &m_submitWakeSemaphore;
+    return info;
   }
   
   
@@ -83,7 +90,7 @@ namespace dxvk {
     
     while (status == VK_TIMEOUT) {
       status = m_vkd->vkWaitForFences(
-        m_vkd->device(), 1, &m_fence, VK_FALSE,
+        m_vkd->device(), 1, &m_submitFence, VK_FALSE,
         1'000'000'000ull);
     }
     
@@ -108,6 +115,8 @@ namespace dxvk {
     if (m_vkd->vkResetFences(m_vkd->device(), 1, &m_fence) != VK_SUCCESS)
       Logger::err("DxvkCommandList: Failed to reset fence");
     
+    m_submitFence = m_fence;
+    
     // Unconditionally mark the exec buffer as used. There
     // is virtually no use case where this isn't correct.
     m_cmdBuffersUsed.set(DxvkCmdBufferFlag::ExecBuffer);
@@ -115,6 +124,8 @@ namespace dxvk {
   
   
   void DxvkCommandList::endRecording() {
+    m_statCounters.addCtr(DxvkStatCounter::CmdTrackedResources, m_resources.count());
+    
     if (m_vkd->vkEndCommandBuffer(m_execBuffer) != VK_SUCCESS
      || m_vkd->vkEndCommandBuffer(m_initBuffer) != VK_SUCCESS)
       Logger::err("DxvkCommandList::endRecording: Failed to record command buffer");
@@ -129,6 +140,44 @@ namespace dxvk {
     m_stagingAlloc.reset();
     m_descriptorPoolTracker.reset();
     m_resources.reset();
+    
+    for (VkSemaphore semaphore : m_waitSemaphores)
+      m_vkd->vkDestroySemaphore(m_vkd->device(), semaphore, nullptr);
+    
+    m_waitSemaphores.clear();
+    
+    m_traceBase = DxvkQueryRevision();
+    m_traceZones.clear();
+  }
+  
+  
+  void DxvkCommandList::writeTraceZones(
+          Tracer::TimePoint       submitTime,
+          double                  timestampPeriod) {
+    DxvkQueryData base;
+    
+    if (m_traceBase.query != nullptr
+     && m_traceBase.query->getData(base) == DxvkQueryStatus::Available) {
+      auto toCpuTime = [&] (uint64_t time) {
+        int64_t ns = int64_t(double(int64_t(time - base.timestamp.time)) * timestampPeriod);
+        return submitTime + std::chrono::duration_cast<Tracer::Clock::duration>(std::chrono::nanoseconds(ns));
+      };
+      
+      for (const auto& zone : m_traceZones) {
+        DxvkQueryData begin;
+        DxvkQueryData end;
+        
+        if (zone.begin.query->getData(begin) == DxvkQueryStatus::Available
+         && zone.end.query->getData(end)     == DxvkQueryStatus::Available) {
+          Tracer::recordGpuZone(zone.name,
+            toCpuTime(begin.timestamp.time),
+            toCpuTime(end.timestamp.time));
+        }
+      }
+    }
+    
+    m_traceBase = DxvkQueryRevision();
+    m_traceZones.clear();
   }
   
   
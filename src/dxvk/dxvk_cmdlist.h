@@ -13,6 +13,8 @@
 #include "dxvk_staging.h"
 #include "dxvk_stats.h"
 
+#include "../util/util_trace.h"
+
 namespace dxvk {
   
   /**
@@ -28,6 +30,18 @@ namespace dxvk {
   
   using DxvkCmdBufferFlags = Flags<DxvkCmdBufferFlag>;
   
+  /**
+   * \brief GPU trace zone
+   * 
+   * Pair of timestamp queries that enclose
+   * a range of commands on the GPU timeline.
+   */
+  struct DxvkTraceZone {
+    const char*         name;
+    DxvkQueryRevision   begin;
+    DxvkQueryRevision   end;
+  };
+  
   /**
    * \brief DXVK command list
    * 
@@ -47,18 +61,68 @@ namespace dxvk {
     ~DxvkCommandList();
     
     /**
-     * \brief Submits command list
+     * \brief Prepares command list for submission
      * 
-     * \param [in] queue Device queue
+     * Fills in a submit info structure for this command
+     * list. The structure references data stored in the
+     * command list, and must not be used after the next
+     * call to \ref beginRecording.
      * \param [in] waitSemaphore Semaphore to wait on
      * \param [in] wakeSemaphore Semaphore to signal
-     * \returns Submission status
+     * \returns Submit info for the command list
      */
-    VkResult submit(
-            VkQueue         queue,
+    VkSubmitInfo prepareSubmit(
             VkSemaphore     waitSemaphore,
             VkSemaphore     wakeSemaphore);
     
+    /**
+     * \brief Queue family of the command list
+     * 
+     * Command lists may only be submitted
+     * to queues of this queue family.
+     * \returns Queue family index
+     */
+    uint32_t queueFamily() const {
+      return m_queueFamily;
+    }
+    
+    /**
+     * \brief Adds a semaphore to wait on
+     * 
+     * The command list takes ownership of the semaphore
+     * and destroys it once execution has completed. This
+     * is used to synchronize with other queues.
+     * \param [in] semaphore The semaphore
+     */
+    void addWaitSemaphore(VkSemaphore semaphore) {
+      m_waitSemaphores.push_back(semaphore);
+    }
+    
+    /**
+     * \brief Fence owned by the command list
+     * 
+     * Must be passed to \c vkQueueSubmit if this is
+     * the last command list in a batch of submissions.
+     * \returns Fence handle
+     */
+    VkFence fence() const {
+      return m_fence;
+    }
+    
+    /**
+     * \brief Sets fence to wait for
+     * 
+     * When multiple command lists are submitted with
+     * a single \c vkQueueSubmit call, only the fence of
+     * the last command list gets signaled. All other
+     * command lists of the batch must use that fence
+     * for synchronization instead of their own.
+     * \param [in] fence Fence signaled by the batch
+     */
+    void setSubmitFence(VkFence fence) {
+      m_submitFence = fence;
+    }
+    
     /**
      * \brief Synchronizes command buffer execution
      * 
@@ -128,10 +192,12 @@ namespace dxvk {
      * Adds a resource to the internal resource tracker.
      * Resources will be kept alive and "in use" until
      * the device can guarantee that the submission has
-     * completed.
+     * completed. Tracking the same resource more than
+     * once per command list has no effect.
      */
-    void trackResource(Rc<DxvkResource> rc) {
-      m_resources.trackResource(std::move(rc));
+    template<typename T>
+    void trackResource(const Rc<T>& rc) {
+      m_resources.trackResource(rc.ptr());
     }
     
     /**
@@ -174,6 +240,17 @@ namespace dxvk {
       m_eventTracker.signalEvents();
     }
     
+    /**
+     * \brief Marks tracked resources as unused
+     * 
+     * Call this after synchronizing with a fence for this
+     * command list. The resources are still referenced
+     * until the command list gets reset.
+     */
+    void notifyObjects() {
+      m_resources.notify();
+    }
+    
     /**
      * \brief Writes back query results
      * 
@@ -185,6 +262,42 @@ namespace dxvk {
       m_queryTracker.writeQueryData();
     }
     
+    /**
+     * \brief Sets trace base timestamp
+     * 
+     * Timestamp written at the start of the command
+     * list. GPU trace zones are placed on the timeline
+     * relative to this timestamp.
+     * \param [in] base Base timestamp query
+     */
+    void setTraceBase(const DxvkQueryRevision& base) {
+      m_traceBase = base;
+    }
+    
+    /**
+     * \brief Adds a GPU trace zone
+     * \param [in] zone Trace zone
+     */
+    void addTraceZone(const DxvkTraceZone& zone) {
+      m_traceZones.push_back(zone);
+    }
+    
+    /**
+     * \brief Writes GPU trace zones
+     * 
+     * Converts GPU timestamps to the CPU time domain and
+     * passes the zones to the tracer. Since there is no
+     * calibrated clock, the base timestamp is assumed to
+     * coincide with the submission time, so zones may be
+     * shifted slightly. Call this after query data has
+     * been written back.
+     * \param [in] submitTime Submission time
+     * \param [in] timestampPeriod Nanoseconds per tick
+     */
+    void writeTraceZones(
+            Tracer::TimePoint             submitTime,
+            double                        timestampPeriod);
+    
     /**
      * \brief Resets the command list
      * 
@@ -213,6 +326,13 @@ namespace dxvk {
     }
     
     
+    void cmdBeginConditionalRendering(
+      const VkConditionalRenderingBeginInfoEXT* pConditionalRenderingBegin) {
+      m_vkd->vkCmdBeginConditionalRenderingEXT(
+        m_execBuffer, pConditionalRenderingBegin);
+    }
+
+
     void cmdBeginQuery(
             VkQueryPool             queryPool,
             uint32_t                query,
@@ -399,6 +519,20 @@ namespace dxvk {
     }
     
     
+    void cmdCopyQueryPoolResults(
+            VkQueryPool             queryPool,
+            uint32_t                firstQuery,
+            uint32_t                queryCount,
+            VkBuffer                dstBuffer,
+            VkDeviceSize            dstOffset,
+            VkDeviceSize            stride,
+            VkQueryResultFlags      flags) {
+      m_vkd->vkCmdCopyQueryPoolResults(m_execBuffer,
+        queryPool, firstQuery, queryCount,
+        dstBuffer, dstOffset, stride, flags);
+    }
+    
+    
     void cmdDispatch(
             uint32_t                x,
             uint32_t                y,
@@ -472,6 +606,11 @@ namespace dxvk {
     }
     
     
+    void cmdEndConditionalRendering() {
+      m_vkd->vkCmdEndConditionalRenderingEXT(m_execBuffer);
+    }
+
+
     void cmdEndQuery(
             VkQueryPool             queryPool,
             uint32_t                query) {
@@ -528,6 +667,8 @@ namespace dxvk {
         memoryBarrierCount,       pMemoryBarriers,
         bufferMemoryBarrierCount, pBufferMemoryBarriers,
         imageMemoryBarrierCount,  pImageMemoryBarriers);
+      
+      m_statCounters.addCtr(DxvkStatCounter::CmdBarrierCount, 1);
     }
     
     
@@ -648,8 +789,10 @@ namespace dxvk {
   private:
     
     Rc<vk::DeviceFn>    m_vkd;
+    uint32_t            m_queueFamily;
     
     VkFence             m_fence;
+    VkFence             m_submitFence;
     
     VkCommandPool       m_pool;
     VkCommandBuffer     m_execBuffer;
@@ -664,6 +807,16 @@ namespace dxvk {
     DxvkBufferTracker   m_bufferTracker;
     DxvkStatCounters    m_statCounters;
     
+    DxvkQueryRevision          m_traceBase;
+    std::vector<DxvkTraceZone> m_traceZones;
+    
+    std::vector<VkSemaphore>       m_waitSemaphores;
+    
+    std::array<VkCommandBuffer, 2>    m_submitBuffers;
+    std::vector<VkSemaphore>          m_submitWaitSemaphores;
+    std::vector<VkPipelineStageFlags> m_submitWaitStages;
+    VkSemaphore                       m_submitWakeSemaphore;
+    
   };
   
 }
\ No newline at end of file
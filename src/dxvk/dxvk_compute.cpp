@@ -50,7 +50,8 @@ namespace dxvk {
   
   
   VkPipeline DxvkComputePipeline::getPipelineHandle(
-    const DxvkComputePipelineStateInfo& state) {
+    const DxvkComputePipelineStateInfo& state,
+          DxvkStatCounters*             stats) {
     VkPipeline newPipelineHandle = VK_NULL_HANDLE;
 
     { std::lock_guard<sync::Spinlock> lock(m_mutex);
@@ -60,7 +61,15 @@ namespace dxvk {
     
       // If no pipeline instance exists with the given state
       // vector, create a new one and add it to the list.
+      auto t0 = std::chrono::high_resolution_clock::now();
       newPipelineHandle = this->compilePipeline(state, m_basePipeline);
+      auto t1 = std::chrono::high_resolution_clock::now();
+      
+      if (stats != nullptr) {
+        stats->addCtr(DxvkStatCounter::PipeCompileCount, 1);
+        stats->addCtr(DxvkStatCounter::PipeCompileTime,
+          std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+      }
       
       // Add new pipeline to the set
       m_pipelines.push_back({ state, newPipelineHandle });
@@ -94,6 +103,8 @@ namespace dxvk {
   VkPipeline DxvkComputePipeline::compilePipeline(
     const DxvkComputePipelineStateInfo& state,
           VkPipeline                    baseHandle) const {
+    TraceZone zone("Compile pipeline");
+    
     std::vector<VkDescriptorSetLayoutBinding> bindings;
 
     if (Logger::logLevel() <= LogLevel::Debug) {
@@ -102,6 +113,7 @@ namespace dxvk {
     }
     
     DxvkSpecConstantData specData;
+    m_pipeMgr->m_specConstants.apply(specData);
     
     for (uint32_t i = 0; i < MaxNumActiveBindings; i++)
       specData.activeBindings[i] = state.bsBindingMask.isBound(i) ? VK_TRUE : VK_FALSE;
@@ -136,7 +148,7 @@ namespace dxvk {
     
     auto t1 = std::chrono::high_resolution_clock::now();
     auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-    Logger::debug(str::format("DxvkComputePipeline: Finished in ", td.count(), " ms"));
+    Logger::log(LogLevel::Debug, "DxvkComputePipeline: Finished in ", td.count(), " ms");
     return pipeline;
   }
 
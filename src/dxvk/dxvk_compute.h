@@ -59,10 +59,13 @@ namespace dxvk {
      * \brief Pipeline handle
      * 
      * \param [in] state Pipeline state
+     * \param [in] stats Stat counters to record compile
+     *    time in, or \c nullptr for background compiles
      * \returns Pipeline handle
      */
     VkPipeline getPipelineHandle(
-      const DxvkComputePipelineStateInfo& state);
+      const DxvkComputePipelineStateInfo& state,
+            DxvkStatCounters*             stats);
     
   private:
     
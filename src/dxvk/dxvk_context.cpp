@@ -21,7 +21,7 @@ namespace dxvk {
     m_metaMipGen  (metaMipGenObjects),
     m_metaPack    (metaPackObjects),
     m_metaResolve (metaResolveObjects),
-    m_queries     (device->vkd()) { }
+    m_queries     (device.ptr()) { }
   
   
   DxvkContext::~DxvkContext() {
@@ -33,13 +33,19 @@ namespace dxvk {
     m_cmd = cmdList;
     m_cmd->beginRecording();
     
+    if (Tracer::isEnabled())
+      m_cmd->setTraceBase(this->writeTraceTimestamp());
+    
     // The current state of the internal command buffer is
     // undefined, so we have to bind and set up everything
     // before any draw or dispatch command is recorded.
     m_flags.clr(
       DxvkContextFlag::GpRenderPassBound,
       DxvkContextFlag::GpXfbActive,
-      DxvkContextFlag::GpClearRenderTargets);
+      DxvkContextFlag::GpClearRenderTargets,
+      DxvkContextFlag::DirtyPredicateEvent);
+    
+    m_foldedClears = 0;
     
     m_flags.set(
       DxvkContextFlag::GpDirtyPipeline,
@@ -64,7 +70,7 @@ namespace dxvk {
     
     m_queries.trackQueryPools(m_cmd);
 
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
 
     m_cmd->endRecording();
     return std::exchange(m_cmd, nullptr);
@@ -82,6 +88,25 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::acquireResources(
+          VkSemaphore                       waitSync,
+          DxvkBarrierSet&                   barriers,
+          std::vector<Rc<DxvkResource>>&    resources) {
+    this->spillRenderPass();
+    this->flushBarriers();
+    
+    if (waitSync != VK_NULL_HANDLE)
+      m_cmd->addWaitSemaphore(waitSync);
+    
+    barriers.recordCommands(m_cmd);
+    
+    for (const auto& resource : resources)
+      m_cmd->trackResource(resource);
+    
+    resources.clear();
+  }
+  
+  
   void DxvkContext::beginQuery(const DxvkQueryRevision& query) {
     query.query->beginRecording(query.revision);
     m_queries.enableQuery(m_cmd, query);
@@ -94,12 +119,80 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::setPredicate(
+    const DxvkBufferSlice&    predicate,
+          VkConditionalRenderingFlagsEXT flags) {
+    // Make sure that pending query results
+    // are written before the predicate is used
+    for (const DxvkPredicateWrite& write : m_predicateWrites) {
+      if (write.predicate.matches(predicate)) {
+        this->spillRenderPass();
+        break;
+      }
+    }
+    
+    m_state.cond.predicate = predicate;
+    m_state.cond.flags     = flags;
+  }
+  
+  
+  void DxvkContext::writePredicate(
+    const DxvkBufferSlice&    predicate,
+    const DxvkQueryRevision&  query) {
+    DxvkPredicateWrite write;
+    write.predicate  = predicate;
+    write.queryCount = query.query->getVulkanQuery(
+      query.revision, write.query);
+    
+    m_predicateWrites.push_back(write);
+    
+    // Copies are only allowed outside of render passes. If
+    // the predicate is currently in use, we have to spill
+    // in order to make the new value visible to draws.
+    if (!m_flags.test(DxvkContextFlag::GpRenderPassBound))
+      this->commitPredicateWrites();
+    else if (m_state.cond.predicate.matches(predicate))
+      this->spillRenderPass();
+  }
+  
+  
+  bool DxvkContext::testPredicate() {
+    if (!m_state.cond.predicate.defined())
+      return true;
+    
+    // Pending writes are only committed outside of render passes
+    for (const DxvkPredicateWrite& write : m_predicateWrites) {
+      if (write.predicate.matches(m_state.cond.predicate)) {
+        this->spillRenderPass();
+        break;
+      }
+    }
+    
+    // Conditional rendering may still read the predicate, so
+    // don't wait for the buffer to become idle. Waiting for
+    // the last predicate write is sufficient, even if that
+    // write targeted a different predicate.
+    if (m_predicateEvent->getStatus() != DxvkEventStatus::Signaled) {
+      if (m_flags.test(DxvkContextFlag::DirtyPredicateEvent))
+        this->flushCommandList();
+      
+      m_predicateEvent->wait();
+    }
+    
+    uint32_t value = *reinterpret_cast<const uint32_t*>(
+      m_state.cond.predicate.mapPtr(0));
+    
+    bool inverted = m_state.cond.flags & VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT;
+    return (value != 0) != inverted;
+  }
+  
+  
   void DxvkContext::bindRenderTargets(
     const DxvkRenderTargets&    targets,
           bool                  spill) {
-    // If necessary, perform clears on the active render targets
-    if (m_flags.test(DxvkContextFlag::GpClearRenderTargets))
-      this->clearRenderPass();
+    // Keep pending clears on the active render targets around,
+    // they may still be folded into a later render pass
+    this->deferRenderPassClears();
     
     // Set up default render pass ops
     m_state.om.renderTargets = targets;
@@ -116,6 +209,9 @@ namespace dxvk {
       // Don't redundantly spill the render pass if
       // the same render targets are bound again
       m_flags.clr(DxvkContextFlag::GpDirtyFramebuffer);
+      
+      if (!m_flags.test(DxvkContextFlag::GpRenderPassBound))
+        this->applyDeferredClears();
     }
 
     if (spill)
@@ -244,6 +340,12 @@ namespace dxvk {
           uint32_t              binding,
     const DxvkBufferSlice&      buffer,
     const DxvkBufferSlice&      counter) {
+    // Rebinding the same buffers does not introduce any new
+    // hazards, so there is no need to end the render pass
+    if (m_state.xfb.buffers [binding].matches(buffer)
+     && m_state.xfb.counters[binding].matches(counter))
+      return;
+    
     this->spillRenderPass();
 
     m_state.xfb.buffers [binding] = buffer;
@@ -264,7 +366,7 @@ namespace dxvk {
     auto slice = buffer->getSliceHandle(offset, length);
 
     if (m_barriers.isBufferDirty(slice, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     constexpr VkDeviceSize updateThreshold = 256;
 
@@ -312,7 +414,7 @@ namespace dxvk {
     auto bufferSlice = bufferView->getSliceHandle();
 
     if (m_barriers.isBufferDirty(bufferSlice, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     // Query pipeline objects to use for this clear operation
     DxvkMetaClearPipeline pipeInfo = m_metaClear->getClearBufferPipeline(
@@ -378,7 +480,7 @@ namespace dxvk {
     const VkImageSubresourceRange&  subresources) {
     this->spillRenderPass();
 
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
     
     VkImageLayout imageLayoutClear = image->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
@@ -390,7 +492,7 @@ namespace dxvk {
       VK_PIPELINE_STAGE_TRANSFER_BIT,
       VK_ACCESS_TRANSFER_WRITE_BIT);
 
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
     
     m_cmd->cmdClearColorImage(image->handle(),
       imageLayoutClear, &value, 1, &subresources);
@@ -413,7 +515,7 @@ namespace dxvk {
     const VkImageSubresourceRange&  subresources) {
     this->spillRenderPass();
     
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
 
     VkImageLayout imageLayoutInitial = image->info().layout;
     VkImageLayout imageLayoutClear   = image->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
@@ -430,7 +532,7 @@ namespace dxvk {
       VK_PIPELINE_STAGE_TRANSFER_BIT,
       VK_ACCESS_TRANSFER_WRITE_BIT);
 
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
     
     m_cmd->cmdClearDepthStencilImage(image->handle(),
       imageLayoutClear, &value, 1, &subresources);
@@ -463,7 +565,7 @@ namespace dxvk {
     std::memset(slice.mapPtr, 0, dataSize);
 
     if (m_barriers.isImageDirty(image, subresources, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     m_transitions.accessImage(
       image, subresources,
@@ -514,39 +616,10 @@ namespace dxvk {
     const VkClearValue&         clearValue) {
     this->updateFramebuffer();
 
-    // Prepare attachment ops
-    DxvkColorAttachmentOps colorOp;
-    colorOp.loadOp        = VK_ATTACHMENT_LOAD_OP_LOAD;
-    colorOp.loadLayout    = imageView->imageInfo().layout;
-    colorOp.storeOp       = VK_ATTACHMENT_STORE_OP_STORE;
-    colorOp.storeLayout   = imageView->imageInfo().layout;
-    
-    DxvkDepthAttachmentOps depthOp;
-    depthOp.loadOpD       = VK_ATTACHMENT_LOAD_OP_LOAD;
-    depthOp.loadOpS       = VK_ATTACHMENT_LOAD_OP_LOAD;
-    depthOp.loadLayout    = imageView->imageInfo().layout;
-    depthOp.storeOpD      = VK_ATTACHMENT_STORE_OP_STORE;
-    depthOp.storeOpS      = VK_ATTACHMENT_STORE_OP_STORE;
-    depthOp.storeLayout   = imageView->imageInfo().layout;
-    
-    if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT)
-      colorOp.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    
-    if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT)
-      depthOp.loadOpD = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    
-    if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT)
-      depthOp.loadOpS = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    
-    if (clearAspects == imageView->info().aspect
-     && imageView->imageInfo().type != VK_IMAGE_TYPE_3D) {
-      colorOp.loadLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-      depthOp.loadLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-    }
-    
     // Check whether the render target view is an attachment
     // of the current framebuffer and is included entirely.
-    // If not, we need to create a temporary framebuffer.
+    // If not, defer the clear until the view gets bound as
+    // a render target, so that we can use the load op.
     int32_t attachmentIndex = -1;
     
     if (m_state.om.framebuffer != nullptr
@@ -554,43 +627,8 @@ namespace dxvk {
       attachmentIndex = m_state.om.framebuffer->findAttachment(imageView);
     
     if (attachmentIndex < 0) {
-      this->spillRenderPass();
-
-      if (m_barriers.isImageDirty(
-          imageView->image(),
-          imageView->subresources(),
-          DxvkAccess::Write))
-        m_barriers.recordCommands(m_cmd);
-      
-      // Set up and bind a temporary framebuffer
-      DxvkRenderTargets attachments;
-      DxvkRenderPassOps ops;
-      
-      if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
-        attachments.color[0].view   = imageView;
-        attachments.color[0].layout = imageView->pickLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-        
-        ops.colorOps[0] = colorOp;
-      } else {
-        attachments.depth.view   = imageView;
-        attachments.depth.layout = imageView->pickLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-        
-        ops.depthOps = depthOp;
-      }
-      
-      this->renderPassBindFramebuffer(
-        m_device->createFramebuffer(attachments),
-        ops, 1, &clearValue);
-      this->renderPassUnbindFramebuffer();
-
-      m_barriers.accessImage(
-        imageView->image(),
-        imageView->subresources(),
-        imageView->imageInfo().layout,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
-        imageView->imageInfo().layout,
-        imageView->imageInfo().stages,
-        imageView->imageInfo().access);
+      this->suspendRenderPass();
+      this->deferClear(imageView, clearAspects, clearValue);
     } else if (m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
       // Clear the attachment in quesion. For color images,
       // the attachment index for the current subpass is
@@ -609,35 +647,11 @@ namespace dxvk {
       clearRect.layerCount          = imageView->info().numLayers;
 
       m_cmd->cmdClearAttachments(1, &clearInfo, 1, &clearRect);
+      m_deferredDiscards.clear();
     } else {
       // Perform the clear when starting the render pass
-      if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
-        m_state.om.renderPassOps.colorOps[attachmentIndex] = colorOp;
-        m_state.om.clearValues[attachmentIndex].color = clearValue.color;
-      }
-      
-      if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT) {
-        m_state.om.renderPassOps.depthOps.loadOpD  = depthOp.loadOpD;
-        m_state.om.renderPassOps.depthOps.storeOpD = depthOp.storeOpD;
-        m_state.om.clearValues[attachmentIndex].depthStencil.depth = clearValue.depthStencil.depth;
-      }
-      
-      if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT) {
-        m_state.om.renderPassOps.depthOps.loadOpS  = depthOp.loadOpS;
-        m_state.om.renderPassOps.depthOps.storeOpS = depthOp.storeOpS;
-        m_state.om.clearValues[attachmentIndex].depthStencil.stencil = clearValue.depthStencil.stencil;
-      }
-
-      if (clearAspects & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) {
-        m_state.om.renderPassOps.depthOps.loadLayout  = depthOp.loadLayout;
-        m_state.om.renderPassOps.depthOps.storeLayout = depthOp.storeLayout;
-
-        if (m_state.om.renderPassOps.depthOps.loadOpD == VK_ATTACHMENT_LOAD_OP_CLEAR
-         && m_state.om.renderPassOps.depthOps.loadOpS == VK_ATTACHMENT_LOAD_OP_CLEAR)
-          m_state.om.renderPassOps.depthOps.loadLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      }
-      
-      m_flags.set(DxvkContextFlag::GpClearRenderTargets);
+      this->setRenderPassClear(attachmentIndex,
+        imageView, clearAspects, clearValue);
     }
   }
   
@@ -672,17 +686,19 @@ namespace dxvk {
 
     if (m_barriers.isBufferDirty(srcSlice, DxvkAccess::Read)
      || m_barriers.isBufferDirty(dstSlice, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
     VkBufferCopy bufferRegion;
     bufferRegion.srcOffset = srcSlice.offset;
     bufferRegion.dstOffset = dstSlice.offset;
     bufferRegion.size      = dstSlice.length;
 
-    m_cmd->cmdCopyBuffer(
+    // Defer the actual copy so that it can be merged with
+    // subsequent copies between the same pair of buffers
+    m_copies.copyBuffer(m_cmd,
       srcSlice.handle,
       dstSlice.handle,
-      1, &bufferRegion);
+      bufferRegion);
 
     m_barriers.accessBuffer(srcSlice,
       VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -752,7 +768,7 @@ namespace dxvk {
     
     if (m_barriers.isImageDirty(dstImage, dstSubresourceRange, DxvkAccess::Write)
      || m_barriers.isBufferDirty(srcSlice, DxvkAccess::Read))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
     // Initialize the image if the entire subresource is covered
     VkImageLayout dstImageLayoutInitial  = dstImage->info().layout;
@@ -915,7 +931,7 @@ namespace dxvk {
     
     if (m_barriers.isImageDirty(srcImage, srcSubresourceRange, DxvkAccess::Write)
      || m_barriers.isBufferDirty(dstSlice, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
     // Select a suitable image layout for the transfer op
     VkImageLayout srcImageLayoutTransfer = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
@@ -1013,7 +1029,7 @@ namespace dxvk {
     auto subresourceRange = vk::makeSubresourceRange(srcSubresource);
 
     if (m_barriers.isImageDirty(srcImage, subresourceRange, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     if (srcImage->info().layout != layout) {
       m_transitions.accessImage(
@@ -1083,10 +1099,12 @@ namespace dxvk {
   void DxvkContext::discardImage(
     const Rc<DxvkImage>&          image,
           VkImageSubresourceRange subresources) {
+    // Pending clears are pointless if we discard the contents
+    this->discardClears(image, subresources);
     this->spillRenderPass();
 
     if (m_barriers.isImageDirty(image, subresources, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     m_barriers.accessImage(image, subresources,
       VK_IMAGE_LAYOUT_UNDEFINED, 0, 0,
@@ -1098,10 +1116,48 @@ namespace dxvk {
   }
 
 
+  void DxvkContext::discardImageView(
+    const Rc<DxvkImageView>&      imageView,
+          VkImageAspectFlags      discardAspects) {
+    this->updateFramebuffer();
+    
+    int32_t attachmentIndex = -1;
+    
+    if (m_state.om.framebuffer != nullptr
+     && m_state.om.framebuffer->isFullSize(imageView))
+      attachmentIndex = m_state.om.framebuffer->findAttachment(imageView);
+    
+    // Views of 3D images may only cover some of the slices
+    if (attachmentIndex < 0
+     || imageView->imageInfo().type == VK_IMAGE_TYPE_3D) {
+      this->discardImage(imageView->image(), imageView->subresources());
+      return;
+    }
+    
+    this->discardClears(imageView->image(), imageView->subresources());
+    
+    // If the render pass is already active, its store ops are
+    // fixed. Ending it here would store the attachments and
+    // load them again for the next draw, so keep the pass
+    // running and change the next pass' load ops once it ends.
+    if (m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
+      m_deferredDiscards.push_back({ imageView, discardAspects });
+      return;
+    }
+    
+    this->setRenderPassDiscard(attachmentIndex, discardAspects);
+  }
+
+
   void DxvkContext::dispatch(
           uint32_t x,
           uint32_t y,
           uint32_t z) {
+    TraceZone zone("Dispatch");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitComputeState();
     
     if (this->validateComputeState()) {
@@ -1110,7 +1166,9 @@ namespace dxvk {
       m_queries.beginQueries(m_cmd,
         VK_QUERY_TYPE_PIPELINE_STATISTICS);
       
+      this->startConditionalRendering();
       m_cmd->cmdDispatch(x, y, z);
+      this->pauseConditionalRendering();
       
       m_queries.endQueries(m_cmd,
         VK_QUERY_TYPE_PIPELINE_STATISTICS);
@@ -1124,13 +1182,18 @@ namespace dxvk {
   
   void DxvkContext::dispatchIndirect(
           VkDeviceSize      offset) {
+    TraceZone zone("Dispatch");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitComputeState();
     
     auto bufferSlice = m_state.id.argBuffer.getSliceHandle(
       offset, sizeof(VkDispatchIndirectCommand));
 
     if (m_barriers.isBufferDirty(bufferSlice, DxvkAccess::Read))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     if (this->validateComputeState()) {
       this->commitComputeInitBarriers();
@@ -1138,9 +1201,11 @@ namespace dxvk {
       m_queries.beginQueries(m_cmd,
         VK_QUERY_TYPE_PIPELINE_STATISTICS);
       
+      this->startConditionalRendering();
       m_cmd->cmdDispatchIndirect(
         bufferSlice.handle,
         bufferSlice.offset);
+      this->pauseConditionalRendering();
       
       m_queries.endQueries(m_cmd,
         VK_QUERY_TYPE_PIPELINE_STATISTICS);
@@ -1165,12 +1230,19 @@ namespace dxvk {
           uint32_t instanceCount,
           uint32_t firstVertex,
           uint32_t firstInstance) {
+    TraceZone zone("Draw");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitGraphicsState(false);
     
     if (this->validateGraphicsState()) {
+      this->startConditionalRendering();
       m_cmd->cmdDraw(
         vertexCount, instanceCount,
         firstVertex, firstInstance);
+      this->pauseConditionalRendering();
       
       this->commitGraphicsPostBarriers();
     }
@@ -1183,15 +1255,22 @@ namespace dxvk {
           VkDeviceSize      offset,
           uint32_t          count,
           uint32_t          stride) {
+    TraceZone zone("Draw");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitGraphicsState(false);
     
     if (this->validateGraphicsState()) {
       auto descriptor = m_state.id.argBuffer.getDescriptor();
       
+      this->startConditionalRendering();
       m_cmd->cmdDrawIndirect(
         descriptor.buffer.buffer,
         descriptor.buffer.offset + offset,
         count, stride);
+      this->pauseConditionalRendering();
       
       this->commitGraphicsPostBarriers();
       this->trackDrawBuffer();
@@ -1207,13 +1286,20 @@ namespace dxvk {
           uint32_t firstIndex,
           uint32_t vertexOffset,
           uint32_t firstInstance) {
+    TraceZone zone("Draw");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitGraphicsState(true);
     
     if (this->validateGraphicsState()) {
+      this->startConditionalRendering();
       m_cmd->cmdDrawIndexed(
         indexCount, instanceCount,
         firstIndex, vertexOffset,
         firstInstance);
+      this->pauseConditionalRendering();
       
       this->commitGraphicsPostBarriers();
     }
@@ -1226,15 +1312,22 @@ namespace dxvk {
           VkDeviceSize      offset,
           uint32_t          count,
           uint32_t          stride) {
+    TraceZone zone("Draw");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitGraphicsState(true);
     
     if (this->validateGraphicsState()) {
       auto descriptor = m_state.id.argBuffer.getDescriptor();
       
+      this->startConditionalRendering();
       m_cmd->cmdDrawIndexedIndirect(
         descriptor.buffer.buffer,
         descriptor.buffer.offset + offset,
         count, stride);
+      this->pauseConditionalRendering();
       
       this->commitGraphicsPostBarriers();
       this->trackDrawBuffer();
@@ -1248,16 +1341,23 @@ namespace dxvk {
     const DxvkBufferSlice&  counterBuffer,
           uint32_t          counterDivisor,
           uint32_t          counterBias) {
+    TraceZone zone("Draw");
+    
+    if (unlikely(!this->testDrawPredicate()))
+      return;
+    
     this->commitGraphicsState(false);
 
     if (this->validateGraphicsState()) {
       auto physSlice = counterBuffer.getSliceHandle();
 
+      this->startConditionalRendering();
       m_cmd->cmdDrawIndirectVertexCount(1, 0,
         physSlice.handle,
         physSlice.offset,
         counterBias,
         counterDivisor);
+      this->pauseConditionalRendering();
       
       this->commitGraphicsPostBarriers();
     }
@@ -1286,97 +1386,17 @@ namespace dxvk {
     
     this->spillRenderPass();
 
-    m_barriers.recordCommands(m_cmd);
-    
-    // Create the a set of framebuffers and image views
-    const Rc<DxvkMetaMipGenRenderPass> mipGenerator
-      = new DxvkMetaMipGenRenderPass(m_device->vkd(), imageView);
-    
-    // Common descriptor set properties that we use to
-    // bind the source image view to the fragment shader
-    VkDescriptorImageInfo descriptorImage;
-    descriptorImage.sampler     = VK_NULL_HANDLE;
-    descriptorImage.imageView   = VK_NULL_HANDLE;
-    descriptorImage.imageLayout = imageView->imageInfo().layout;
-    
-    VkWriteDescriptorSet descriptorWrite;
-    descriptorWrite.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptorWrite.pNext            = nullptr;
-    descriptorWrite.dstSet           = VK_NULL_HANDLE;
-    descriptorWrite.dstBinding       = 0;
-    descriptorWrite.dstArrayElement  = 0;
-    descriptorWrite.descriptorCount  = 1;
-    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptorWrite.pImageInfo       = &descriptorImage;
-    descriptorWrite.pBufferInfo      = nullptr;
-    descriptorWrite.pTexelBufferView = nullptr;
-    
-    // Common render pass info
-    VkRenderPassBeginInfo passInfo;
-    passInfo.sType            = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    passInfo.pNext            = nullptr;
-    passInfo.renderPass       = mipGenerator->renderPass();
-    passInfo.framebuffer      = VK_NULL_HANDLE;
-    passInfo.renderArea       = VkRect2D { };
-    passInfo.clearValueCount  = 0;
-    passInfo.pClearValues     = nullptr;
-    
-    // Retrieve a compatible pipeline to use for rendering
-    DxvkMetaMipGenPipeline pipeInfo = m_metaMipGen->getPipeline(
-      mipGenerator->viewType(), imageView->info().format);
+    const DxvkImageCreateInfo& imageInfo = imageView->imageInfo();
     
-    for (uint32_t i = 0; i < mipGenerator->passCount(); i++) {
-      DxvkMetaMipGenPass pass = mipGenerator->pass(i);
-      
-      // Width, height and layer count for the current pass
-      VkExtent3D passExtent = mipGenerator->passExtent(i);
-      
-      // Create descriptor set with the current source view
-      descriptorImage.imageView = pass.srcView;
-      descriptorWrite.dstSet = allocateDescriptorSet(pipeInfo.dsetLayout);
-      m_cmd->updateDescriptorSets(1, &descriptorWrite);
-      
-      // Set up viewport and scissor rect
-      VkViewport viewport;
-      viewport.x        = 0.0f;
-      viewport.y        = 0.0f;
-      viewport.width    = float(passExtent.width);
-      viewport.height   = float(passExtent.height);
-      viewport.minDepth = 0.0f;
-      viewport.maxDepth = 1.0f;
-      
-      VkRect2D scissor;
-      scissor.offset    = { 0, 0 };
-      scissor.extent    = { passExtent.width, passExtent.height };
-      
-      // Set up render pass info
-      passInfo.framebuffer = pass.framebuffer;
-      passInfo.renderArea  = scissor;
-      
-      // Set up push constants
-      DxvkMetaMipGenPushConstants pushConstants;
-      pushConstants.layerCount = passExtent.depth;
-      
-      m_cmd->cmdBeginRenderPass(&passInfo, VK_SUBPASS_CONTENTS_INLINE);
-      m_cmd->cmdBindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeHandle);
-      m_cmd->cmdBindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS,
-        pipeInfo.pipeLayout, descriptorWrite.dstSet, 0, nullptr);
-      
-      m_cmd->cmdSetViewport(0, 1, &viewport);
-      m_cmd->cmdSetScissor (0, 1, &scissor);
-      
-      m_cmd->cmdPushConstants(
-        pipeInfo.pipeLayout,
-        VK_SHADER_STAGE_FRAGMENT_BIT,
-        0, sizeof(pushConstants),
-        &pushConstants);
-      
-      m_cmd->cmdDraw(1, passExtent.depth, 0, 0);
-      m_cmd->cmdEndRenderPass();
-    }
+    bool useCompute = (imageInfo.usage & VK_IMAGE_USAGE_STORAGE_BIT)
+      && DxvkMetaMipGenCompute::isSupported(m_device.ptr(), imageInfo,
+           imageView->info().format, imageView->mipLevelExtent(0),
+           imageView->info().numLevels);
     
-    m_cmd->trackResource(mipGenerator);
-    m_cmd->trackResource(imageView->image());
+    if (useCompute)
+      this->generateMipmapsCompute(imageView);
+    else
+      this->generateMipmapsFb(imageView);
   }
   
   
@@ -1455,7 +1475,7 @@ namespace dxvk {
     this->spillRenderPass();
     
     if (srcLayout != dstLayout) {
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
       m_barriers.accessImage(
         dstImage, dstSubresources,
@@ -1486,7 +1506,7 @@ namespace dxvk {
     auto bufferSlice = buffer->getSliceHandle(offset, size);
 
     if (m_barriers.isBufferDirty(bufferSlice, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     if ((size <= 4096) && ((size & 0x3) == 0) && ((offset & 0x3) == 0)) {
       m_cmd->cmdUpdateBuffer(
@@ -1498,11 +1518,15 @@ namespace dxvk {
       auto slice = m_cmd->stagedAlloc(size);
       std::memcpy(slice.mapPtr, data, size);
 
-      m_cmd->stagedBufferCopy(
+      VkBufferCopy bufferRegion;
+      bufferRegion.srcOffset = slice.offset;
+      bufferRegion.dstOffset = bufferSlice.offset;
+      bufferRegion.size      = bufferSlice.length;
+
+      m_copies.copyBuffer(m_cmd,
+        slice.buffer,
         bufferSlice.handle,
-        bufferSlice.offset,
-        bufferSlice.length,
-        slice);
+        bufferRegion);
     }
 
     m_barriers.accessBuffer(
@@ -1555,7 +1579,7 @@ namespace dxvk {
     subresourceRange.aspectMask = formatInfo->aspectMask;
 
     if (m_barriers.isImageDirty(image, subresourceRange, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
     // Initialize the image if the entire subresource is covered
     VkImageLayout imageLayoutInitial  = image->info().layout;
@@ -1763,6 +1787,8 @@ namespace dxvk {
   
   
   void DxvkContext::writeTimestamp(const DxvkQueryRevision& query) {
+    m_copies.recordCommands(m_cmd);
+
     DxvkQueryHandle handle = m_queries.allocQuery(m_cmd, query);
     
     m_cmd->cmdWriteTimestamp(
@@ -1794,7 +1820,7 @@ namespace dxvk {
           imageView->image(),
           imageView->subresources(),
           DxvkAccess::Write))
-        m_barriers.recordCommands(m_cmd);
+        this->flushBarriers();
       
       // Set up a temporary framebuffer
       DxvkRenderTargets attachments;
@@ -1854,6 +1880,7 @@ namespace dxvk {
     clearRect.layerCount          = imageView->info().numLayers;
 
     m_cmd->cmdClearAttachments(1, &clearInfo, 1, &clearRect);
+    m_deferredDiscards.clear();
 
     // Unbind temporary framebuffer
     if (attachmentIndex < 0)
@@ -1873,7 +1900,7 @@ namespace dxvk {
           imageView->image(),
           imageView->subresources(),
           DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
     
     // Query pipeline objects to use for this clear operation
     DxvkMetaClearPipeline pipeInfo = m_metaClear->getClearImagePipeline(
@@ -1958,7 +1985,7 @@ namespace dxvk {
     
     if (m_barriers.isImageDirty(dstImage, dstSubresourceRange, DxvkAccess::Write)
      || m_barriers.isImageDirty(srcImage, srcSubresourceRange, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
     VkImageLayout dstImageLayout = dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
     VkImageLayout srcImageLayout = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
@@ -2027,7 +2054,7 @@ namespace dxvk {
           VkImageSubresourceLayers srcSubresource,
           VkOffset3D            srcOffset,
           VkExtent3D            extent) {
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
 
     auto srcSubresourceRange = vk::makeSubresourceRange(srcSubresource);
 
@@ -2107,40 +2134,39 @@ namespace dxvk {
       ? VK_IMAGE_VIEW_TYPE_1D_ARRAY
       : VK_IMAGE_VIEW_TYPE_2D_ARRAY;
     
-    DxvkImageViewCreateInfo tgtViewInfo;
-    tgtViewInfo.type      = viewType;
-    tgtViewInfo.format    = viewFormat;
-    tgtViewInfo.usage     = tgtUsage;
-    tgtViewInfo.aspect    = tgtSubresource.aspectMask;
-    tgtViewInfo.minLevel  = tgtSubresource.mipLevel;
-    tgtViewInfo.numLevels = 1;
-    tgtViewInfo.minLayer  = tgtSubresource.baseArrayLayer;
-    tgtViewInfo.numLayers = tgtSubresource.layerCount;
-
-    DxvkImageViewCreateInfo srcViewInfo;
-    srcViewInfo.type      = viewType;
-    srcViewInfo.format    = srcImage->info().format;
-    srcViewInfo.usage     = VK_IMAGE_USAGE_SAMPLED_BIT;
-    srcViewInfo.aspect    = srcSubresource.aspectMask;
-    srcViewInfo.minLevel  = srcSubresource.mipLevel;
-    srcViewInfo.numLevels = 1;
-    srcViewInfo.minLayer  = srcSubresource.baseArrayLayer;
-    srcViewInfo.numLayers = srcSubresource.layerCount;
-
-    auto tgtImageView = m_device->createImageView(tgtImage, tgtViewInfo);
-    auto srcImageView = m_device->createImageView(srcImage, srcViewInfo);
-
-    // Create framebuffer and pipeline for the copy
-    Rc<DxvkMetaCopyRenderPass> fb = new DxvkMetaCopyRenderPass(
-      m_device->vkd(), tgtImageView, srcImageView,
-      tgtImage->isFullSubresource(tgtSubresource, extent));
+    DxvkMetaViewKey tgtViewKey;
+    tgtViewKey.type         = viewType;
+    tgtViewKey.format       = viewFormat;
+    tgtViewKey.usage        = tgtUsage;
+    tgtViewKey.subresources = vk::makeSubresourceRange(tgtSubresource);
+
+    DxvkMetaViewKey srcViewKey;
+    srcViewKey.type         = viewType;
+    srcViewKey.format       = srcImage->info().format;
+    srcViewKey.usage        = VK_IMAGE_USAGE_SAMPLED_BIT;
+    srcViewKey.subresources = srcSubresourceRange;
+
+    // Look up render pass, framebuffer and pipeline for the copy. All
+    // of these are cached, so that repeated copies do not create any
+    // Vulkan objects. Views and framebuffers are owned by the images.
+    DxvkMetaCopyRenderPassKey passKey;
+    passKey.format  = viewFormat;
+    passKey.samples = tgtImage->info().sampleCount;
+    passKey.aspect  = tgtSubresource.aspectMask;
+    passKey.layout  = tgtImage->info().layout;
+    passKey.stages  = tgtImage->info().stages;
+    passKey.access  = tgtImage->info().access;
+    passKey.discard = tgtImage->isFullSubresource(tgtSubresource, extent);
+
+    VkRenderPass  renderPass  = m_metaCopy->getRenderPass(passKey);
+    VkFramebuffer framebuffer = tgtImage->getMetaFramebuffer(tgtViewKey, renderPass);
     
     auto pipeInfo = m_metaCopy->getPipeline(
       viewType, viewFormat, tgtImage->info().sampleCount);
     
     VkDescriptorImageInfo descriptorImage;
     descriptorImage.sampler          = VK_NULL_HANDLE;
-    descriptorImage.imageView        = srcImageView->handle();
+    descriptorImage.imageView        = srcImage->getMetaView(srcViewKey);
     descriptorImage.imageLayout      = srcLayout;
 
     VkWriteDescriptorSet descriptorWrite;
@@ -2172,8 +2198,8 @@ namespace dxvk {
     VkRenderPassBeginInfo info;
     info.sType              = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     info.pNext              = nullptr;
-    info.renderPass         = fb->renderPass();
-    info.framebuffer        = fb->framebuffer();
+    info.renderPass         = renderPass;
+    info.framebuffer        = framebuffer;
     info.renderArea.offset  = { 0, 0 };
     info.renderArea.extent  = {
       tgtImage->info().extent.width,
@@ -2204,7 +2230,6 @@ namespace dxvk {
 
     m_cmd->trackResource(tgtImage);
     m_cmd->trackResource(srcImage);
-    m_cmd->trackResource(fb);
 
     // If necessary, transition source image back
     if (srcImage->info().layout != srcLayout) {
@@ -2229,25 +2254,309 @@ namespace dxvk {
   }
 
 
-  void DxvkContext::resolveImageHw(
-    const Rc<DxvkImage>&            dstImage,
-    const VkImageSubresourceLayers& dstSubresources,
-    const Rc<DxvkImage>&            srcImage,
-    const VkImageSubresourceLayers& srcSubresources) {
-    auto dstSubresourceRange = vk::makeSubresourceRange(dstSubresources);
-    auto srcSubresourceRange = vk::makeSubresourceRange(srcSubresources);
+  void DxvkContext::generateMipmapsCompute(
+    const Rc<DxvkImageView>&        imageView) {
+    this->unbindComputePipeline();
     
-    if (m_barriers.isImageDirty(dstImage, dstSubresourceRange, DxvkAccess::Write)
-     || m_barriers.isImageDirty(srcImage, srcSubresourceRange, DxvkAccess::Write))
-      m_barriers.recordCommands(m_cmd);
+    const Rc<DxvkImage>& image = imageView->image();
     
-    // We only support resolving to the entire image
-    // area, so we might as well discard its contents
-    m_transitions.accessImage(
-      dstImage, dstSubresourceRange,
-      VK_IMAGE_LAYOUT_UNDEFINED, 0, 0,
-      dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL),
-      VK_PIPELINE_STAGE_TRANSFER_BIT,
+    uint32_t levelCount = imageView->info().numLevels - 1;
+    uint32_t layerCount = imageView->info().numLayers;
+    
+    VkExtent3D srcExtent = imageView->mipLevelExtent(0);
+    
+    // Each workgroup processes one tile of the top-most level,
+    // the size of which is a multiple of the tile size or less
+    VkExtent2D tileCount = {
+      std::max(srcExtent.width  / DxvkMetaMipGenCompute::TileSize, 1u),
+      std::max(srcExtent.height / DxvkMetaMipGenCompute::TileSize, 1u) };
+    
+    Rc<DxvkBuffer> scratchBuffer = this->getMipGenScratchBuffer();
+    
+    VkDeviceSize counterSize = DxvkMetaMipGenCompute::CounterSize;
+    VkDeviceSize texelSize   = scratchBuffer->info().size - counterSize;
+    
+    // Move all involved subresources to the GENERAL layout,
+    // which supports both sampled and storage image access
+    VkImageSubresourceRange subresources = imageView->subresources();
+    
+    if (m_barriers.isImageDirty(image, subresources, DxvkAccess::Write)
+     || m_barriers.isBufferDirty(scratchBuffer->getSliceHandle(), DxvkAccess::Write))
+      this->flushBarriers();
+    
+    m_transitions.accessImage(
+      image, vk::makeSubresourceRange(vk::pickSubresourceLayers(subresources, 0)),
+      image->info().layout,
+      image->info().stages,
+      image->info().access,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT);
+    
+    VkImageSubresourceRange dstSubresources = subresources;
+    dstSubresources.baseMipLevel += 1;
+    dstSubresources.levelCount   -= 1;
+    
+    m_transitions.accessImage(
+      image, dstSubresources,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      image->info().stages,
+      image->info().access,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_WRITE_BIT);
+    
+    m_transitions.recordCommands(m_cmd);
+    
+    DxvkMetaMipGenComputePipeline pipeInfo = m_metaMipGen->getComputePipeline();
+    
+    DxvkMetaMipGenComputeArgs args;
+    args.srcExtent  = { srcExtent.width, srcExtent.height };
+    args.tileCount  = tileCount;
+    args.levelCount = levelCount;
+    
+    m_cmd->cmdBindPipeline(
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      pipeInfo.pipeHandle);
+    
+    m_cmd->cmdPushConstants(
+      pipeInfo.pipeLayout,
+      VK_SHADER_STAGE_COMPUTE_BIT,
+      0, sizeof(args), &args);
+    
+    // Process array layers in batches, since the scratch
+    // buffer only has room for a fixed number of layers
+    for (uint32_t layer = 0; layer < layerCount; layer += DxvkMetaMipGenCompute::BatchLayers) {
+      uint32_t batchSize = std::min(layerCount - layer, DxvkMetaMipGenCompute::BatchLayers);
+      
+      // Look up one view for the top-most level, and
+      // one storage image view for each mip level
+      DxvkMetaViewKey srcViewKey;
+      srcViewKey.type   = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+      srcViewKey.format = imageView->info().format;
+      srcViewKey.usage  = VK_IMAGE_USAGE_SAMPLED_BIT;
+      srcViewKey.subresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+      srcViewKey.subresources.baseMipLevel   = imageView->info().minLevel;
+      srcViewKey.subresources.levelCount     = 1;
+      srcViewKey.subresources.baseArrayLayer = imageView->info().minLayer + layer;
+      srcViewKey.subresources.layerCount     = batchSize;
+      
+      VkImageView srcView = image->getMetaView(srcViewKey);
+      
+      std::array<VkImageView, DxvkMetaMipGenCompute::MaxLevels> dstViews;
+      
+      for (uint32_t i = 0; i < levelCount; i++) {
+        DxvkMetaViewKey dstViewKey = srcViewKey;
+        dstViewKey.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+        dstViewKey.subresources.baseMipLevel += i + 1;
+        
+        dstViews[i] = image->getMetaView(dstViewKey);
+      }
+      
+      // Unused level descriptors still need to be valid
+      DxvkMetaMipGenComputeDescriptors descriptors;
+      descriptors.srcImage = { VK_NULL_HANDLE, srcView, VK_IMAGE_LAYOUT_GENERAL };
+      
+      for (uint32_t i = 0; i < DxvkMetaMipGenCompute::MaxLevels; i++) {
+        descriptors.dstImages[i] = { VK_NULL_HANDLE,
+          dstViews[std::min(i, levelCount - 1)],
+          VK_IMAGE_LAYOUT_GENERAL };
+      }
+      
+      descriptors.counters = scratchBuffer->getDescriptor(0, counterSize).buffer;
+      descriptors.texels   = scratchBuffer->getDescriptor(counterSize, texelSize).buffer;
+      
+      VkDescriptorSet dset = allocateDescriptorSet(pipeInfo.dsetLayout);
+      m_cmd->updateDescriptorSetWithTemplate(dset, pipeInfo.dsetTemplate, &descriptors);
+      
+      m_cmd->cmdBindDescriptorSet(
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        pipeInfo.pipeLayout, dset,
+        0, nullptr);
+      
+      // The previous batch must be done with the scratch buffer
+      if (m_barriers.isBufferDirty(scratchBuffer->getSliceHandle(), DxvkAccess::Write))
+        this->flushBarriers();
+      
+      m_cmd->cmdDispatch(
+        tileCount.width,
+        tileCount.height,
+        batchSize);
+      
+      m_barriers.accessBuffer(
+        scratchBuffer->getSliceHandle(),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT |
+        VK_ACCESS_SHADER_WRITE_BIT,
+        scratchBuffer->info().stages,
+        scratchBuffer->info().access);
+    }
+    
+    m_barriers.accessImage(
+      image, subresources,
+      VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT |
+      VK_ACCESS_SHADER_WRITE_BIT,
+      image->info().layout,
+      image->info().stages,
+      image->info().access);
+    
+    m_cmd->trackResource(image);
+    m_cmd->trackResource(scratchBuffer);
+  }
+  
+  
+  void DxvkContext::generateMipmapsFb(
+    const Rc<DxvkImageView>&        imageView) {
+    this->flushBarriers();
+    
+    // Look up the render pass as well as the image views and
+    // framebuffers for each level, all of which are cached
+    DxvkMetaMipGenRenderPassKey passKey;
+    passKey.format = imageView->info().format;
+    passKey.layout = imageView->imageInfo().layout;
+    passKey.stages = imageView->imageInfo().stages;
+    passKey.access = imageView->imageInfo().access;
+    
+    DxvkMetaMipGenRenderPass mipGenerator(
+      m_metaMipGen->getRenderPass(passKey), imageView);
+    
+    // Common descriptor set properties that we use to
+    // bind the source image view to the fragment shader
+    VkDescriptorImageInfo descriptorImage;
+    descriptorImage.sampler     = VK_NULL_HANDLE;
+    descriptorImage.imageView   = VK_NULL_HANDLE;
+    descriptorImage.imageLayout = imageView->imageInfo().layout;
+    
+    VkWriteDescriptorSet descriptorWrite;
+    descriptorWrite.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.pNext            = nullptr;
+    descriptorWrite.dstSet           = VK_NULL_HANDLE;
+    descriptorWrite.dstBinding       = 0;
+    descriptorWrite.dstArrayElement  = 0;
+    descriptorWrite.descriptorCount  = 1;
+    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrite.pImageInfo       = &descriptorImage;
+    descriptorWrite.pBufferInfo      = nullptr;
+    descriptorWrite.pTexelBufferView = nullptr;
+    
+    // Common render pass info
+    VkRenderPassBeginInfo passInfo;
+    passInfo.sType            = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    passInfo.pNext            = nullptr;
+    passInfo.renderPass       = mipGenerator.renderPass();
+    passInfo.framebuffer      = VK_NULL_HANDLE;
+    passInfo.renderArea       = VkRect2D { };
+    passInfo.clearValueCount  = 0;
+    passInfo.pClearValues     = nullptr;
+    
+    // Retrieve a compatible pipeline to use for rendering
+    DxvkMetaMipGenPipeline pipeInfo = m_metaMipGen->getPipeline(
+      mipGenerator.viewType(), imageView->info().format);
+    
+    for (uint32_t i = 0; i < mipGenerator.passCount(); i++) {
+      DxvkMetaMipGenPass pass = mipGenerator.pass(i);
+      
+      // Width, height and layer count for the current pass
+      VkExtent3D passExtent = mipGenerator.passExtent(i);
+      
+      // Create descriptor set with the current source view
+      descriptorImage.imageView = pass.srcView;
+      descriptorWrite.dstSet = allocateDescriptorSet(pipeInfo.dsetLayout);
+      m_cmd->updateDescriptorSets(1, &descriptorWrite);
+      
+      // Set up viewport and scissor rect
+      VkViewport viewport;
+      viewport.x        = 0.0f;
+      viewport.y        = 0.0f;
+      viewport.width    = float(passExtent.width);
+      viewport.height   = float(passExtent.height);
+      viewport.minDepth = 0.0f;
+      viewport.maxDepth = 1.0f;
+      
+      VkRect2D scissor;
+      scissor.offset    = { 0, 0 };
+      scissor.extent    = { passExtent.width, passExtent.height };
+      
+      // Set up render pass info
+      passInfo.framebuffer = pass.framebuffer;
+      passInfo.renderArea  = scissor;
+      
+      // Set up push constants
+      DxvkMetaMipGenPushConstants pushConstants;
+      pushConstants.layerCount = passExtent.depth;
+      
+      m_cmd->cmdBeginRenderPass(&passInfo, VK_SUBPASS_CONTENTS_INLINE);
+      m_cmd->cmdBindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeHandle);
+      m_cmd->cmdBindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pipeInfo.pipeLayout, descriptorWrite.dstSet, 0, nullptr);
+      
+      m_cmd->cmdSetViewport(0, 1, &viewport);
+      m_cmd->cmdSetScissor (0, 1, &scissor);
+      
+      m_cmd->cmdPushConstants(
+        pipeInfo.pipeLayout,
+        VK_SHADER_STAGE_FRAGMENT_BIT,
+        0, sizeof(pushConstants),
+        &pushConstants);
+      
+      m_cmd->cmdDraw(1, passExtent.depth, 0, 0);
+      m_cmd->cmdEndRenderPass();
+    }
+    
+    m_cmd->trackResource(imageView->image());
+  }
+  
+  
+  Rc<DxvkBuffer> DxvkContext::getMipGenScratchBuffer() {
+    if (m_mipGenScratch != nullptr)
+      return m_mipGenScratch;
+    
+    // Sized for one batch of layers, which is 1 MiB
+    VkDeviceSize counterSize = DxvkMetaMipGenCompute::CounterSize;
+    VkDeviceSize texelSize   = DxvkMetaMipGenCompute::TexelSize
+                             * DxvkMetaMipGenCompute::BatchLayers;
+    
+    DxvkBufferCreateInfo info;
+    info.size   = counterSize + texelSize;
+    info.usage  = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    info.stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    info.access = VK_ACCESS_SHADER_READ_BIT
+                | VK_ACCESS_SHADER_WRITE_BIT
+                | VK_ACCESS_TRANSFER_WRITE_BIT;
+    
+    m_mipGenScratch = m_device->createBuffer(info,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    
+    // The shader resets the counters after use, so
+    // they only need to be cleared once on creation
+    this->clearBuffer(m_mipGenScratch, 0, counterSize, 0);
+    return m_mipGenScratch;
+  }
+  
+  
+  void DxvkContext::resolveImageHw(
+    const Rc<DxvkImage>&            dstImage,
+    const VkImageSubresourceLayers& dstSubresources,
+    const Rc<DxvkImage>&            srcImage,
+    const VkImageSubresourceLayers& srcSubresources) {
+    auto dstSubresourceRange = vk::makeSubresourceRange(dstSubresources);
+    auto srcSubresourceRange = vk::makeSubresourceRange(srcSubresources);
+    
+    if (m_barriers.isImageDirty(dstImage, dstSubresourceRange, DxvkAccess::Write)
+     || m_barriers.isImageDirty(srcImage, srcSubresourceRange, DxvkAccess::Write))
+      this->flushBarriers();
+    
+    // We only support resolving to the entire image
+    // area, so we might as well discard its contents
+    m_transitions.accessImage(
+      dstImage, dstSubresourceRange,
+      VK_IMAGE_LAYOUT_UNDEFINED, 0, 0,
+      dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL),
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
       VK_ACCESS_TRANSFER_WRITE_BIT);
 
     m_transitions.accessImage(
@@ -2300,43 +2609,39 @@ namespace dxvk {
     const Rc<DxvkImage>&            srcImage,
     const VkImageSubresourceLayers& srcSubresources,
           VkFormat                  format) {
-    m_barriers.recordCommands(m_cmd);
+    this->flushBarriers();
+
+    // Image views covering the requested subresources
+    DxvkMetaViewKey dstViewKey;
+    dstViewKey.type         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    dstViewKey.format       = format;
+    dstViewKey.usage        = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    dstViewKey.subresources = vk::makeSubresourceRange(dstSubresources);
+
+    DxvkMetaViewKey srcViewKey;
+    srcViewKey.type         = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    srcViewKey.format       = format;
+    srcViewKey.usage        = VK_IMAGE_USAGE_SAMPLED_BIT;
+    srcViewKey.subresources = vk::makeSubresourceRange(srcSubresources);
+
+    // Look up the cached render pass, framebuffer
+    // and pipeline objects for the resolve op
+    DxvkMetaResolveRenderPassKey passKey;
+    passKey.format = format;
+    passKey.layout = dstImage->info().layout;
+    passKey.stages = dstImage->info().stages;
+    passKey.access = dstImage->info().access;
 
-    // Create image views covering the requested subresourcs
-    DxvkImageViewCreateInfo dstViewInfo;
-    dstViewInfo.type      = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-    dstViewInfo.format    = format;
-    dstViewInfo.usage     = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    dstViewInfo.aspect    = dstSubresources.aspectMask;
-    dstViewInfo.minLevel  = dstSubresources.mipLevel;
-    dstViewInfo.numLevels = 1;
-    dstViewInfo.minLayer  = dstSubresources.baseArrayLayer;
-    dstViewInfo.numLayers = dstSubresources.layerCount;
-
-    DxvkImageViewCreateInfo srcViewInfo;
-    srcViewInfo.type      = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-    srcViewInfo.format    = format;
-    srcViewInfo.usage     = VK_IMAGE_USAGE_SAMPLED_BIT;
-    srcViewInfo.aspect    = srcSubresources.aspectMask;
-    srcViewInfo.minLevel  = srcSubresources.mipLevel;
-    srcViewInfo.numLevels = 1;
-    srcViewInfo.minLayer  = srcSubresources.baseArrayLayer;
-    srcViewInfo.numLayers = srcSubresources.layerCount;
-
-    Rc<DxvkImageView> dstImageView = m_device->createImageView(dstImage, dstViewInfo);
-    Rc<DxvkImageView> srcImageView = m_device->createImageView(srcImage, srcViewInfo);
-
-    // Create a framebuffer and pipeline for the resolve op
     DxvkMetaResolvePipeline pipeInfo = m_metaResolve->getPipeline(format);
 
-    Rc<DxvkMetaResolveRenderPass> fb = new DxvkMetaResolveRenderPass(
-      m_device->vkd(), dstImageView, srcImageView);
+    VkRenderPass  renderPass  = m_metaResolve->getRenderPass(passKey);
+    VkFramebuffer framebuffer = dstImage->getMetaFramebuffer(dstViewKey, renderPass);
 
     // Create descriptor set pointing to the source image
     VkDescriptorImageInfo descriptorImage;
     descriptorImage.sampler          = VK_NULL_HANDLE;
-    descriptorImage.imageView        = srcImageView->handle();
-    descriptorImage.imageLayout      = srcImageView->imageInfo().layout;
+    descriptorImage.imageView        = srcImage->getMetaView(srcViewKey);
+    descriptorImage.imageLayout      = srcImage->info().layout;
 
     VkWriteDescriptorSet descriptorWrite;
     descriptorWrite.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -2353,7 +2658,7 @@ namespace dxvk {
     m_cmd->updateDescriptorSets(1, &descriptorWrite);
 
     // Set up viewport and scissor rect
-    VkExtent3D passExtent = dstImageView->mipLevelExtent(0);
+    VkExtent3D passExtent = dstImage->mipLevelExtent(dstSubresources.mipLevel);
     passExtent.depth = dstSubresources.layerCount;
 
     VkViewport viewport;
@@ -2372,8 +2677,8 @@ namespace dxvk {
     VkRenderPassBeginInfo info;
     info.sType              = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     info.pNext              = nullptr;
-    info.renderPass         = fb->renderPass();
-    info.framebuffer        = fb->framebuffer();
+    info.renderPass         = renderPass;
+    info.framebuffer        = framebuffer;
     info.renderArea.offset  = { 0, 0 };
     info.renderArea.extent  = { passExtent.width, passExtent.height };
     info.clearValueCount    = 0;
@@ -2391,7 +2696,6 @@ namespace dxvk {
     m_cmd->cmdDraw(1, passExtent.depth, 0, 0);
     m_cmd->cmdEndRenderPass();
 
-    m_cmd->trackResource(fb);
     m_cmd->trackResource(dstImage);
     m_cmd->trackResource(srcImage);
   }
@@ -2400,10 +2704,27 @@ namespace dxvk {
   void DxvkContext::startRenderPass() {
     if (!m_flags.test(DxvkContextFlag::GpRenderPassBound)
      && (m_state.om.framebuffer != nullptr)) {
+      // Fold deferred clears of framebuffer attachments into
+      // the render pass, e.g. if they were moved back to the
+      // deferred list when the render pass got suspended.
+      // Clears of any other views must be executed separately.
+      if (!m_deferredClears.empty()) {
+        this->applyDeferredClears();
+        this->flushClears();
+      }
+      
+      // Deferred clears folded into this render pass
+      // will never have to be executed separately
+      if (m_foldedClears) {
+        m_cmd->addStatCtr(DxvkStatCounter::CmdClearsElided, bit::popcnt(m_foldedClears));
+        m_foldedClears = 0;
+      }
+      
       m_flags.set(DxvkContextFlag::GpRenderPassBound);
-      m_flags.clr(DxvkContextFlag::GpClearRenderTargets);
+      m_flags.clr(DxvkContextFlag::GpClearRenderTargets,
+                  DxvkContextFlag::GpDiscardRenderTargets);
 
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
 
       this->renderPassBindFramebuffer(
         m_state.om.framebuffer,
@@ -2425,9 +2746,32 @@ namespace dxvk {
   
   
   void DxvkContext::spillRenderPass() {
+    // Deferred clears were recorded before any pending
+    // clears of the current framebuffer, see deferClear
+    if (!m_deferredClears.empty())
+      this->flushClears();
+    
     if (m_flags.test(DxvkContextFlag::GpClearRenderTargets))
       this->clearRenderPass();
     
+    if (m_flags.test(DxvkContextFlag::GpDiscardRenderTargets))
+      this->keepRenderPassContents();
+    
+    this->endRenderPass();
+  }
+  
+  
+  void DxvkContext::suspendRenderPass() {
+    this->deferRenderPassClears();
+    
+    if (m_flags.test(DxvkContextFlag::GpDiscardRenderTargets))
+      this->keepRenderPassContents();
+    
+    this->endRenderPass();
+  }
+  
+  
+  void DxvkContext::endRenderPass() {
     if (m_flags.test(DxvkContextFlag::GpRenderPassBound)) {
       m_flags.clr(DxvkContextFlag::GpRenderPassBound);
 
@@ -2440,13 +2784,32 @@ namespace dxvk {
       this->unbindGraphicsPipeline();
 
       m_flags.clr(DxvkContextFlag::GpDirtyXfbCounters);
+      
+      if (!m_predicateWrites.empty())
+        this->commitPredicateWrites();
+      
+      if (!m_deferredDiscards.empty())
+        this->applyDeferredDiscards();
     }
   }
 
 
+  void DxvkContext::keepRenderPassContents() {
+    // Discards only apply to the contents that the render pass
+    // would have loaded. Any command that may access the render
+    // targets in the meantime must see them load their contents.
+    m_flags.clr(DxvkContextFlag::GpDiscardRenderTargets);
+    
+    this->resetRenderPassOps(
+      m_state.om.renderTargets,
+      m_state.om.renderPassOps);
+  }
+
+
   void DxvkContext::clearRenderPass() {
     if (m_flags.test(DxvkContextFlag::GpClearRenderTargets)) {
       m_flags.clr(DxvkContextFlag::GpClearRenderTargets);
+      m_foldedClears = 0;
 
       bool flushBarriers = false;
 
@@ -2460,7 +2823,7 @@ namespace dxvk {
       }
 
       if (flushBarriers)
-        m_barriers.recordCommands(m_cmd);
+        this->flushBarriers();
 
       this->renderPassBindFramebuffer(
         m_state.om.framebuffer,
@@ -2490,6 +2853,330 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::setRenderPassClear(
+          uint32_t              attachmentIndex,
+    const Rc<DxvkImageView>&    imageView,
+          VkImageAspectFlags    clearAspects,
+    const VkClearValue&         clearValue) {
+    DxvkColorAttachmentOps colorOp;
+    DxvkDepthAttachmentOps depthOp;
+    
+    this->getClearOps(imageView, clearAspects, colorOp, depthOp);
+    
+    if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
+      m_state.om.renderPassOps.colorOps[attachmentIndex] = colorOp;
+      m_state.om.clearValues[attachmentIndex].color = clearValue.color;
+    }
+    
+    if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT) {
+      m_state.om.renderPassOps.depthOps.loadOpD  = depthOp.loadOpD;
+      m_state.om.renderPassOps.depthOps.storeOpD = depthOp.storeOpD;
+      m_state.om.clearValues[attachmentIndex].depthStencil.depth = clearValue.depthStencil.depth;
+    }
+    
+    if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT) {
+      m_state.om.renderPassOps.depthOps.loadOpS  = depthOp.loadOpS;
+      m_state.om.renderPassOps.depthOps.storeOpS = depthOp.storeOpS;
+      m_state.om.clearValues[attachmentIndex].depthStencil.stencil = clearValue.depthStencil.stencil;
+    }
+
+    if (clearAspects & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) {
+      m_state.om.renderPassOps.depthOps.loadLayout  = depthOp.loadLayout;
+      m_state.om.renderPassOps.depthOps.storeLayout = depthOp.storeLayout;
+
+      if (m_state.om.renderPassOps.depthOps.loadOpD == VK_ATTACHMENT_LOAD_OP_CLEAR
+       && m_state.om.renderPassOps.depthOps.loadOpS == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        m_state.om.renderPassOps.depthOps.loadLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    
+    m_flags.set(DxvkContextFlag::GpClearRenderTargets);
+  }
+  
+  
+  VkImageAspectFlags DxvkContext::getRenderPassClearAspects(
+          uint32_t              attachmentIndex,
+    const Rc<DxvkImageView>&    imageView) const {
+    if (!m_flags.test(DxvkContextFlag::GpClearRenderTargets))
+      return 0;
+    
+    const DxvkRenderPassOps& ops = m_state.om.renderPassOps;
+    VkImageAspectFlags result = 0;
+    
+    if (imageView->info().aspect & VK_IMAGE_ASPECT_COLOR_BIT) {
+      if (ops.colorOps[attachmentIndex].loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        result |= VK_IMAGE_ASPECT_COLOR_BIT;
+    } else {
+      if (ops.depthOps.loadOpD == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        result |= VK_IMAGE_ASPECT_DEPTH_BIT;
+      if (ops.depthOps.loadOpS == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        result |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    
+    return result;
+  }
+  
+  
+  void DxvkContext::setRenderPassDiscard(
+          uint32_t              attachmentIndex,
+          VkImageAspectFlags    discardAspects) {
+    // Let the next render pass skip loading the attachment
+    DxvkRenderPassOps& ops = m_state.om.renderPassOps;
+    
+    if (discardAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
+      ops.colorOps[attachmentIndex].loadOp     = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+      ops.colorOps[attachmentIndex].loadLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    
+    if (discardAspects & VK_IMAGE_ASPECT_DEPTH_BIT)
+      ops.depthOps.loadOpD = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    
+    if (discardAspects & VK_IMAGE_ASPECT_STENCIL_BIT)
+      ops.depthOps.loadOpS = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    
+    if (discardAspects & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) {
+      if (ops.depthOps.loadOpD != VK_ATTACHMENT_LOAD_OP_LOAD
+       && ops.depthOps.loadOpS != VK_ATTACHMENT_LOAD_OP_LOAD)
+        ops.depthOps.loadLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    
+    m_flags.set(DxvkContextFlag::GpDiscardRenderTargets);
+  }
+  
+  
+  void DxvkContext::getClearOps(
+    const Rc<DxvkImageView>&    imageView,
+          VkImageAspectFlags    clearAspects,
+          DxvkColorAttachmentOps& colorOp,
+          DxvkDepthAttachmentOps& depthOp) const {
+    colorOp.loadOp        = VK_ATTACHMENT_LOAD_OP_LOAD;
+    colorOp.loadLayout    = imageView->imageInfo().layout;
+    colorOp.storeOp       = VK_ATTACHMENT_STORE_OP_STORE;
+    colorOp.storeLayout   = imageView->imageInfo().layout;
+    
+    depthOp.loadOpD       = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depthOp.loadOpS       = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depthOp.loadLayout    = imageView->imageInfo().layout;
+    depthOp.storeOpD      = VK_ATTACHMENT_STORE_OP_STORE;
+    depthOp.storeOpS      = VK_ATTACHMENT_STORE_OP_STORE;
+    depthOp.storeLayout   = imageView->imageInfo().layout;
+    
+    if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT)
+      colorOp.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    
+    if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT)
+      depthOp.loadOpD = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    
+    if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT)
+      depthOp.loadOpS = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    
+    if (clearAspects == imageView->info().aspect
+     && imageView->imageInfo().type != VK_IMAGE_TYPE_3D) {
+      colorOp.loadLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+      depthOp.loadLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+  }
+  
+  
+  void DxvkContext::deferClear(
+    const Rc<DxvkImageView>&    imageView,
+          VkImageAspectFlags    clearAspects,
+    const VkClearValue&         clearValue) {
+    for (size_t i = 0; i < m_deferredClears.size(); i++) {
+      DxvkDeferredClear& entry = m_deferredClears[i];
+      
+      if (entry.imageView == imageView) {
+        // The previous clear is dead if this one overwrites
+        // all of its aspects, otherwise merge the two
+        if (!(entry.clearAspects & ~clearAspects))
+          m_cmd->addStatCtr(DxvkStatCounter::CmdClearsElided, 1);
+        
+        if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT)
+          entry.clearValue.color = clearValue.color;
+        
+        if (clearAspects & VK_IMAGE_ASPECT_DEPTH_BIT)
+          entry.clearValue.depthStencil.depth = clearValue.depthStencil.depth;
+        
+        if (clearAspects & VK_IMAGE_ASPECT_STENCIL_BIT)
+          entry.clearValue.depthStencil.stencil = clearValue.depthStencil.stencil;
+        
+        entry.clearAspects |= clearAspects;
+        return;
+      }
+      
+      // Clears of different views of the same image may overlap.
+      // Execute the old one now so that we never have to worry
+      // about the order in which deferred clears are executed.
+      if (entry.imageView->image() == imageView->image()) {
+        this->performClear(entry.imageView, entry.clearAspects, entry.clearValue);
+        m_deferredClears.erase(m_deferredClears.begin() + i--);
+      }
+    }
+    
+    m_deferredClears.push_back({ imageView, clearAspects, clearValue });
+  }
+  
+  
+  void DxvkContext::deferRenderPassClears() {
+    if (!m_flags.test(DxvkContextFlag::GpClearRenderTargets))
+      return;
+    
+    // Turn pending clears of the current framebuffer back into
+    // deferred clears, so that a later render pass that uses
+    // the same views can still perform them via load ops.
+    const Rc<DxvkFramebuffer>& framebuffer = m_state.om.framebuffer;
+    
+    for (uint32_t i = 0; i < framebuffer->numAttachments(); i++) {
+      const DxvkAttachment& attachment = framebuffer->getAttachment(i);
+      
+      VkImageAspectFlags clearAspects = this->getRenderPassClearAspects(i, attachment.view);
+      
+      if (clearAspects) {
+        this->deferClear(attachment.view, clearAspects, m_state.om.clearValues[i]);
+      } else if (m_foldedClears & (1u << i)) {
+        // A folded clear was discarded in the meantime
+        m_cmd->addStatCtr(DxvkStatCounter::CmdClearsElided, 1);
+      }
+    }
+    
+    m_flags.clr(DxvkContextFlag::GpClearRenderTargets);
+    m_foldedClears = 0;
+    
+    this->resetRenderPassOps(
+      m_state.om.renderTargets,
+      m_state.om.renderPassOps);
+  }
+  
+  
+  void DxvkContext::applyDeferredClears() {
+    const Rc<DxvkFramebuffer>& framebuffer = m_state.om.framebuffer;
+    
+    if (framebuffer == nullptr)
+      return;
+    
+    for (size_t i = 0; i < m_deferredClears.size(); i++) {
+      const DxvkDeferredClear& entry = m_deferredClears[i];
+      
+      int32_t attachmentIndex = -1;
+      
+      if (framebuffer->isFullSize(entry.imageView))
+        attachmentIndex = framebuffer->findAttachment(entry.imageView);
+      
+      if (attachmentIndex >= 0) {
+        // Clears that are already pending for the attachment
+        // were recorded after the deferred one, so they win
+        VkImageAspectFlags clearAspects = entry.clearAspects
+          & ~this->getRenderPassClearAspects(attachmentIndex, entry.imageView);
+        
+        if (clearAspects) {
+          this->setRenderPassClear(attachmentIndex,
+            entry.imageView, clearAspects, entry.clearValue);
+          
+          // Counted once the render pass actually starts
+          m_foldedClears |= 1u << attachmentIndex;
+        } else {
+          m_cmd->addStatCtr(DxvkStatCounter::CmdClearsElided, 1);
+        }
+        
+        m_deferredClears.erase(m_deferredClears.begin() + i--);
+      }
+    }
+  }
+  
+  
+  void DxvkContext::discardClears(
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceRange&  subresources) {
+    for (size_t i = 0; i < m_deferredClears.size(); i++) {
+      const DxvkDeferredClear& entry = m_deferredClears[i];
+      
+      if (entry.imageView->image() != image)
+        continue;
+      
+      VkImageSubresourceRange clearSubres = entry.imageView->subresources();
+      
+      if (clearSubres.baseMipLevel   >= subresources.baseMipLevel
+       && clearSubres.baseMipLevel   + clearSubres.levelCount <= subresources.baseMipLevel + subresources.levelCount
+       && clearSubres.baseArrayLayer >= subresources.baseArrayLayer
+       && clearSubres.baseArrayLayer + clearSubres.layerCount <= subresources.baseArrayLayer + subresources.layerCount) {
+        m_cmd->addStatCtr(DxvkStatCounter::CmdClearsElided, 1);
+        m_deferredClears.erase(m_deferredClears.begin() + i--);
+      }
+    }
+  }
+  
+  
+  void DxvkContext::applyDeferredDiscards() {
+    // If different render targets are about to be bound, the
+    // render pass ops have already been reset for those, and
+    // the next pass using the discarded views loads them.
+    if (!m_flags.test(DxvkContextFlag::GpDirtyFramebuffer)) {
+      for (const auto& entry : m_deferredDiscards) {
+        int32_t attachmentIndex = m_state.om.framebuffer->findAttachment(entry.imageView);
+        
+        if (attachmentIndex >= 0)
+          this->setRenderPassDiscard(attachmentIndex, entry.discardAspects);
+      }
+    }
+    
+    m_deferredDiscards.clear();
+  }
+  
+  
+  void DxvkContext::flushClears() {
+    for (const auto& entry : m_deferredClears)
+      this->performClear(entry.imageView, entry.clearAspects, entry.clearValue);
+    
+    m_deferredClears.clear();
+  }
+  
+  
+  void DxvkContext::performClear(
+    const Rc<DxvkImageView>&    imageView,
+          VkImageAspectFlags    clearAspects,
+    const VkClearValue&         clearValue) {
+    if (m_barriers.isImageDirty(
+        imageView->image(),
+        imageView->subresources(),
+        DxvkAccess::Write))
+      this->flushBarriers();
+    
+    DxvkColorAttachmentOps colorOp;
+    DxvkDepthAttachmentOps depthOp;
+    
+    this->getClearOps(imageView, clearAspects, colorOp, depthOp);
+    
+    // Set up and bind a temporary framebuffer
+    DxvkRenderTargets attachments;
+    DxvkRenderPassOps ops;
+    
+    if (clearAspects & VK_IMAGE_ASPECT_COLOR_BIT) {
+      attachments.color[0].view   = imageView;
+      attachments.color[0].layout = imageView->pickLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+      
+      ops.colorOps[0] = colorOp;
+    } else {
+      attachments.depth.view   = imageView;
+      attachments.depth.layout = imageView->pickLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+      
+      ops.depthOps = depthOp;
+    }
+    
+    this->renderPassBindFramebuffer(
+      m_device->createFramebuffer(attachments),
+      ops, 1, &clearValue);
+    this->renderPassUnbindFramebuffer();
+
+    m_barriers.accessImage(
+      imageView->image(),
+      imageView->subresources(),
+      imageView->imageInfo().layout,
+      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+      imageView->imageInfo().layout,
+      imageView->imageInfo().stages,
+      imageView->imageInfo().access);
+  }
+  
+  
   void DxvkContext::renderPassBindFramebuffer(
     const Rc<DxvkFramebuffer>&  framebuffer,
     const DxvkRenderPassOps&    ops,
@@ -2510,6 +3197,9 @@ namespace dxvk {
     info.clearValueCount      = clearValueCount;
     info.pClearValues         = clearValues;
     
+    if (Tracer::isEnabled())
+      m_traceRenderPass = this->writeTraceTimestamp();
+    
     m_cmd->cmdBeginRenderPass(&info,
       VK_SUBPASS_CONTENTS_INLINE);
     
@@ -2526,6 +3216,13 @@ namespace dxvk {
   
   void DxvkContext::renderPassUnbindFramebuffer() {
     m_cmd->cmdEndRenderPass();
+    
+    if (m_traceRenderPass.query != nullptr) {
+      m_cmd->addTraceZone({ "Render pass",
+        std::move(m_traceRenderPass),
+        this->writeTraceTimestamp() });
+      m_traceRenderPass = DxvkQueryRevision();
+    }
   }
   
   
@@ -2657,6 +3354,110 @@ namespace dxvk {
   }
 
 
+  bool DxvkContext::testDrawPredicate() {
+    // Without conditional rendering, draws and dispatches
+    // have to evaluate the predicate on the CPU as well
+    if (likely(!m_state.cond.predicate.defined()
+     || m_device->features().extConditionalRendering.conditionalRendering))
+      return true;
+    
+    return this->testPredicate();
+  }
+  
+  
+  void DxvkContext::startConditionalRendering() {
+    if (!m_state.cond.predicate.defined()
+     || !m_device->features().extConditionalRendering.conditionalRendering)
+      return;
+    
+    auto predicate = m_state.cond.predicate.getSliceHandle();
+    
+    // Render passes flush all pending barriers when they
+    // begin, so this can only happen for dispatches
+    if (m_barriers.isBufferDirty(predicate, DxvkAccess::Read))
+      this->flushBarriers();
+    
+    VkConditionalRenderingBeginInfoEXT info;
+    info.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+    info.pNext  = nullptr;
+    info.buffer = predicate.handle;
+    info.offset = predicate.offset;
+    info.flags  = m_state.cond.flags;
+    
+    m_cmd->cmdBeginConditionalRendering(&info);
+    m_cmd->trackResource(m_state.cond.predicate.buffer());
+  }
+  
+  
+  void DxvkContext::pauseConditionalRendering() {
+    // Conditional rendering is only enabled around individual
+    // draws and dispatches, so that clears and meta operations
+    // which use draws or dispatches internally are not affected.
+    if (m_state.cond.predicate.defined()
+     && m_device->features().extConditionalRendering.conditionalRendering)
+      m_cmd->cmdEndConditionalRendering();
+  }
+  
+  
+  void DxvkContext::commitPredicateWrites() {
+    for (const DxvkPredicateWrite& write : m_predicateWrites) {
+      auto predicate = write.predicate.getSliceHandle();
+      
+      if (m_barriers.isBufferDirty(predicate, DxvkAccess::Write))
+        this->flushBarriers();
+      
+      if (write.queryCount == 1 && m_queries.isQueryPoolAlive(write.query.queryPool)) {
+        // Conditional rendering only reads 32 bits. Results are
+        // truncated, which only causes a false negative if the
+        // sample count is a non-zero multiple of 2^32, and since
+        // the query is not precise, implementations may return
+        // any non-zero value for visible samples anyway.
+        m_cmd->cmdCopyQueryPoolResults(
+          write.query.queryPool,
+          write.query.queryId, 1,
+          predicate.handle,
+          predicate.offset,
+          sizeof(uint32_t),
+          VK_QUERY_RESULT_WAIT_BIT);
+      } else {
+        // If no query was recorded, nothing was drawn. Otherwise, if
+        // multiple queries were used or the query pool may no longer
+        // exist, we cannot resolve the result on the GPU, so we'll
+        // conservatively pass the predicate.
+        m_cmd->cmdFillBuffer(
+          predicate.handle,
+          predicate.offset,
+          sizeof(uint32_t),
+          write.queryCount ? 1 : 0);
+      }
+      
+      m_barriers.accessBuffer(predicate,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        write.predicate.bufferInfo().stages,
+        write.predicate.bufferInfo().access);
+      
+      m_cmd->trackResource(write.predicate.buffer());
+    }
+    
+    // Lets testPredicate wait for this command list only
+    m_cmd->trackEvent({ m_predicateEvent, m_predicateEvent->reset() });
+    m_flags.set(DxvkContextFlag::DirtyPredicateEvent);
+    
+    m_predicateWrites.clear();
+  }
+  
+  
+  DxvkQueryRevision DxvkContext::writeTraceTimestamp() {
+    DxvkQueryRevision query;
+    query.query    = new DxvkQuery(VK_QUERY_TYPE_TIMESTAMP, 0);
+    query.revision = query.query->reset();
+    
+    this->writeTimestamp(query);
+    return query;
+  }
+  
+  
   void DxvkContext::unbindComputePipeline() {
     m_flags.set(
       DxvkContextFlag::CpDirtyPipeline,
@@ -2685,7 +3486,7 @@ namespace dxvk {
       m_flags.clr(DxvkContextFlag::CpDirtyPipelineState);
       
       m_cpActivePipeline = m_state.cp.pipeline != nullptr
-        ? m_state.cp.pipeline->getPipelineHandle(m_state.cp.state)
+        ? m_state.cp.pipeline->getPipelineHandle(m_state.cp.state, &m_cmd->statCounters())
         : VK_NULL_HANDLE;
       
       if (m_cpActivePipeline != VK_NULL_HANDLE) {
@@ -2773,7 +3574,7 @@ namespace dxvk {
       // Retrieve and bind actual Vulkan pipeline handle
       m_gpActivePipeline = m_state.gp.pipeline != nullptr && m_state.om.framebuffer != nullptr
         ? m_state.gp.pipeline->getPipelineHandle(m_state.gp.state,
-            m_state.om.framebuffer->getRenderPass())
+            m_state.om.framebuffer->getRenderPass(), &m_cmd->statCounters())
         : VK_NULL_HANDLE;
       
       if (m_gpActivePipeline != VK_NULL_HANDLE) {
@@ -3026,7 +3827,7 @@ namespace dxvk {
     if (m_flags.test(DxvkContextFlag::GpDirtyFramebuffer)) {
       m_flags.clr(DxvkContextFlag::GpDirtyFramebuffer);
       
-      this->spillRenderPass();
+      this->suspendRenderPass();
       
       auto fb = m_device->createFramebuffer(m_state.om.renderTargets);
       
@@ -3041,6 +3842,8 @@ namespace dxvk {
           : VkComponentMapping();
       }
 
+      this->applyDeferredClears();
+
       m_flags.set(DxvkContextFlag::GpDirtyPipelineState);
     }
   }
@@ -3229,8 +4032,14 @@ namespace dxvk {
     if (m_flags.test(DxvkContextFlag::GpRenderPassBound))
       this->spillRenderPass();
 
+    if (!m_deferredClears.empty())
+      this->flushClears();
+
     if (m_flags.test(DxvkContextFlag::GpClearRenderTargets))
       this->clearRenderPass();
+
+    if (m_flags.test(DxvkContextFlag::GpDiscardRenderTargets))
+      this->keepRenderPassContents();
     
     if (m_flags.test(DxvkContextFlag::CpDirtyPipeline))
       this->updateComputePipeline();
@@ -3257,6 +4066,10 @@ namespace dxvk {
     if (!m_flags.test(DxvkContextFlag::GpRenderPassBound))
       this->startRenderPass();
     
+    // Draws may write to discarded attachments
+    if (!m_deferredDiscards.empty())
+      m_deferredDiscards.clear();
+    
     if (m_flags.test(DxvkContextFlag::GpDirtyPipeline))
       this->updateGraphicsPipeline();
     
@@ -3357,7 +4170,7 @@ namespace dxvk {
     }
 
     if (requiresBarrier)
-      m_barriers.recordCommands(m_cmd);
+      this->flushBarriers();
   }
   
 
@@ -3444,11 +4257,19 @@ namespace dxvk {
   }
 
 
+  void DxvkContext::flushBarriers() {
+    m_copies.recordCommands(m_cmd);
+    m_barriers.recordCommands(m_cmd);
+  }
+
+
   void DxvkContext::emitMemoryBarrier(
           VkPipelineStageFlags      srcStages,
           VkAccessFlags             srcAccess,
           VkPipelineStageFlags      dstStages,
           VkAccessFlags             dstAccess) {
+    m_copies.recordCommands(m_cmd);
+
     VkMemoryBarrier barrier;
     barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
     barrier.pNext         = nullptr;
@@ -3474,6 +4295,7 @@ namespace dxvk {
       set = m_descPool->alloc(layout);
     }
 
+    m_cmd->addStatCtr(DxvkStatCounter::CmdDescriptorSetCount, 1);
     return set;
   }
 
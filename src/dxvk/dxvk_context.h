@@ -4,6 +4,7 @@
 #include "dxvk_bind_mask.h"
 #include "dxvk_cmdlist.h"
 #include "dxvk_context_state.h"
+#include "dxvk_copy_batch.h"
 #include "dxvk_data.h"
 #include "dxvk_event.h"
 #include "dxvk_meta_clear.h"
@@ -73,6 +74,25 @@ namespace dxvk {
      */
     void flushCommandList();
     
+    /**
+     * \brief Acquires resources from another queue
+     * 
+     * Records the acquire half of queue family ownership
+     * transfers, as well as any layout transitions that
+     * are part of them. The resources are tracked by the
+     * current command list, since the barriers reference
+     * them. Resets the given barrier set and resource list.
+     * \param [in] waitSync (Optional) Semaphore signaled
+     *    by the releasing queue. The current command list
+     *    waits on it and takes ownership of it.
+     * \param [in] barriers Acquire barriers
+     * \param [in] resources Resources used by the barriers
+     */
+    void acquireResources(
+            VkSemaphore                       waitSync,
+            DxvkBarrierSet&                   barriers,
+            std::vector<Rc<DxvkResource>>&    resources);
+    
     /**
      * \brief Begins generating query data
      * \param [in] query The query to end
@@ -87,6 +107,50 @@ namespace dxvk {
     void endQuery(
       const DxvkQueryRevision&  query);
     
+    /**
+     * \brief Sets predicate for draws and dispatches
+     * 
+     * Draws and dispatches will be skipped on the GPU
+     * if the 32-bit value stored in the predicate is
+     * zero, or non-zero if the predicate is inverted.
+     * \param [in] predicate Predicate buffer slice, or
+     *    an undefined slice to disable predication
+     * \param [in] flags Conditional rendering flags
+     */
+    void setPredicate(
+      const DxvkBufferSlice&    predicate,
+            VkConditionalRenderingFlagsEXT flags);
+    
+    /**
+     * \brief Writes query result to a predicate
+     * 
+     * Copies the result of an occlusion query to a
+     * predicate buffer on the GPU. Must be called
+     * right after the query has been ended. If the
+     * query cannot be resolved on the GPU, the
+     * predicate will be set to a non-zero value.
+     * \param [in] predicate Predicate buffer slice
+     * \param [in] query The occlusion query
+     */
+    void writePredicate(
+      const DxvkBufferSlice&    predicate,
+      const DxvkQueryRevision&  query);
+    
+    /**
+     * \brief Evaluates the predicate on the CPU
+     * 
+     * Used for operations that conditional rendering does
+     * not apply to, such as copies and clears. Reads back
+     * the value written by the last \ref writePredicate
+     * call. If that value is not yet available, this waits
+     * for the command list containing the most recent
+     * predicate write, and submits the current command
+     * list first if necessary. The predicate buffer must
+     * be host-visible.
+     * \returns \c true if the operation should be executed
+     */
+    bool testPredicate();
+    
     /**
      * \brief Sets render targets
      * 
@@ -450,6 +514,23 @@ namespace dxvk {
       const Rc<DxvkImage>&          image,
             VkImageSubresourceRange subresources);
     
+    /**
+     * \brief Discards an image view
+     * 
+     * If the view is a full-size attachment of the current
+     * framebuffer, this only changes the load ops of the
+     * next render pass that uses the framebuffer. If the
+     * render pass is active, it keeps running, and the load
+     * ops are changed once it ends unless anything is drawn
+     * in the meantime. Store ops are not affected either way.
+     * Otherwise, this behaves like \ref discardImage.
+     * \param [in] imageView The image view to discard
+     * \param [in] discardAspects Image aspects to discard
+     */
+    void discardImageView(
+      const Rc<DxvkImageView>&      imageView,
+            VkImageAspectFlags      discardAspects);
+    
     /**
      * \brief Starts compute jobs
      * 
@@ -545,8 +626,10 @@ namespace dxvk {
     /**
      * \brief Generates mip maps
      * 
-     * Uses blitting to generate lower mip levels from
-     * the top-most mip level passed to this method.
+     * Generates lower mip levels from the top-most mip
+     * level passed to this method. Uses a single compute
+     * dispatch if possible, and a series of render passes
+     * otherwise.
      * \param [in] imageView The image to generate mips for
      */
     void generateMipmaps(
@@ -798,7 +881,21 @@ namespace dxvk {
     DxvkBarrierSet          m_transitions;
     DxvkBarrierControlFlags m_barrierControl;
     
+    DxvkBufferCopyBatch     m_copies;
+    
+    std::vector<DxvkDeferredClear> m_deferredClears;
+    uint32_t                       m_foldedClears = 0;
+    
+    std::vector<DxvkDeferredDiscard> m_deferredDiscards;
+    
     DxvkQueryManager        m_queries;
+    
+    std::vector<DxvkPredicateWrite> m_predicateWrites;
+    Rc<DxvkEvent>                   m_predicateEvent = new DxvkEvent();
+    
+    DxvkQueryRevision       m_traceRenderPass;
+    
+    Rc<DxvkBuffer>          m_mipGenScratch;
 
     VkPipeline m_gpActivePipeline = VK_NULL_HANDLE;
     VkPipeline m_cpActivePipeline = VK_NULL_HANDLE;
@@ -840,6 +937,14 @@ namespace dxvk {
             VkOffset3D            srcOffset,
             VkExtent3D            extent);
     
+    void generateMipmapsCompute(
+      const Rc<DxvkImageView>&        imageView);
+    
+    void generateMipmapsFb(
+      const Rc<DxvkImageView>&        imageView);
+    
+    Rc<DxvkBuffer> getMipGenScratchBuffer();
+    
     void resolveImageHw(
       const Rc<DxvkImage>&            dstImage,
       const VkImageSubresourceLayers& dstSubresources,
@@ -855,8 +960,52 @@ namespace dxvk {
     
     void startRenderPass();
     void spillRenderPass();
+    void suspendRenderPass();
+    void endRenderPass();
+    void keepRenderPassContents();
     void clearRenderPass();
     
+    void setRenderPassClear(
+            uint32_t              attachmentIndex,
+      const Rc<DxvkImageView>&    imageView,
+            VkImageAspectFlags    clearAspects,
+      const VkClearValue&         clearValue);
+    
+    VkImageAspectFlags getRenderPassClearAspects(
+            uint32_t              attachmentIndex,
+      const Rc<DxvkImageView>&    imageView) const;
+    
+    void setRenderPassDiscard(
+            uint32_t              attachmentIndex,
+            VkImageAspectFlags    discardAspects);
+    
+    void getClearOps(
+      const Rc<DxvkImageView>&    imageView,
+            VkImageAspectFlags    clearAspects,
+            DxvkColorAttachmentOps& colorOp,
+            DxvkDepthAttachmentOps& depthOp) const;
+    
+    void deferClear(
+      const Rc<DxvkImageView>&    imageView,
+            VkImageAspectFlags    clearAspects,
+      const VkClearValue&         clearValue);
+    
+    void deferRenderPassClears();
+    void applyDeferredClears();
+    
+    void discardClears(
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceRange&  subresources);
+    
+    void applyDeferredDiscards();
+    
+    void flushClears();
+    
+    void performClear(
+      const Rc<DxvkImageView>&    imageView,
+            VkImageAspectFlags    clearAspects,
+      const VkClearValue&         clearValue);
+    
     void renderPassBindFramebuffer(
       const Rc<DxvkFramebuffer>&  framebuffer,
       const DxvkRenderPassOps&    ops,
@@ -872,6 +1021,15 @@ namespace dxvk {
     void startTransformFeedback();
     void pauseTransformFeedback();
     
+    bool testDrawPredicate();
+    
+    void startConditionalRendering();
+    void pauseConditionalRendering();
+    
+    void commitPredicateWrites();
+    
+    DxvkQueryRevision writeTraceTimestamp();
+    
     void unbindComputePipeline();
     void updateComputePipeline();
     void updateComputePipelineState();
@@ -921,6 +1079,8 @@ namespace dxvk {
     
     void commitGraphicsPostBarriers();
 
+    void flushBarriers();
+
     void emitMemoryBarrier(
             VkPipelineStageFlags      srcStages,
             VkAccessFlags             srcAccess,
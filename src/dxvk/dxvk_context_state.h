@@ -8,6 +8,7 @@
 #include "dxvk_image.h"
 #include "dxvk_limits.h"
 #include "dxvk_pipelayout.h"
+#include "dxvk_query.h"
 #include "dxvk_sampler.h"
 #include "dxvk_shader.h"
 
@@ -24,6 +25,7 @@ namespace dxvk {
     GpRenderPassBound,          ///< Render pass is currently bound
     GpXfbActive,                ///< Transform feedback is enabled
     GpClearRenderTargets,       ///< Render targets need to be cleared
+    GpDiscardRenderTargets,     ///< Render pass load ops discard render targets
     GpDirtyFramebuffer,         ///< Framebuffer binding is out of date
     GpDirtyPipeline,            ///< Graphics pipeline binding is out of date
     GpDirtyPipelineState,       ///< Graphics pipeline needs to be recompiled
@@ -42,6 +44,8 @@ namespace dxvk {
     GpDynamicDepthBias,         ///< Depth bias is dynamic
     GpDynamicStencilRef,        ///< Stencil reference is dynamic
     
+    DirtyPredicateEvent,        ///< Predicate writes recorded into the current command list
+    
     CpDirtyPipeline,            ///< Compute pipeline binding are out of date
     CpDirtyPipelineState,       ///< Compute pipeline needs to be recompiled
     CpDirtyResources,           ///< Compute pipeline resource bindings are out of date
@@ -97,12 +101,61 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Deferred clear
+   * 
+   * Clear of a render target view that is not part
+   * of the current framebuffer. Deferred clears are
+   * folded into the next render pass that uses the
+   * view, or executed separately if necessary.
+   */
+  struct DxvkDeferredClear {
+    Rc<DxvkImageView>   imageView;
+    VkImageAspectFlags  clearAspects;
+    VkClearValue        clearValue;
+  };
+  
+  
+  /**
+   * \brief Deferred discard
+   * 
+   * Discard of an attachment of the active render
+   * pass. Applied to the load ops of the next render
+   * pass once the active one ends.
+   */
+  struct DxvkDeferredDiscard {
+    Rc<DxvkImageView>   imageView;
+    VkImageAspectFlags  discardAspects;
+  };
+
+
   struct DxvkXfbState {
     std::array<DxvkBufferSlice, MaxNumXfbBuffers> buffers;
     std::array<DxvkBufferSlice, MaxNumXfbBuffers> counters;
   };
   
   
+  struct DxvkCondRenderState {
+    DxvkBufferSlice                 predicate;
+    VkConditionalRenderingFlagsEXT  flags = 0;
+  };
+  
+  
+  /**
+   * \brief Predicate write
+   * 
+   * Stores the Vulkan query whose result will be
+   * copied to a predicate buffer. Since copies are
+   * not allowed inside a render pass, these may
+   * need to be deferred until the render pass ends.
+   */
+  struct DxvkPredicateWrite {
+    DxvkBufferSlice predicate;
+    DxvkQueryHandle query;
+    uint32_t        queryCount;
+  };
+  
+  
   struct DxvkShaderStage {
     Rc<DxvkShader> shader;
   };
@@ -149,6 +202,7 @@ namespace dxvk {
     DxvkOutputMergerState     om;
     DxvkXfbState              xfb;
     DxvkDynamicState          dyn;
+    DxvkCondRenderState       cond;
     
     DxvkGraphicsPipelineState gp;
     DxvkComputePipelineState  cp;
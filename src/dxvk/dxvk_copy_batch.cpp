@@ -0,0 +1,58 @@
+#include "dxvk_copy_batch.h"
+
+namespace dxvk {
+  
+  DxvkBufferCopyBatch::DxvkBufferCopyBatch() {
+    m_regions.reserve(MaxRegions);
+  }
+  
+  
+  DxvkBufferCopyBatch::~DxvkBufferCopyBatch() {
+    
+  }
+  
+  
+  void DxvkBufferCopyBatch::copyBuffer(
+    const Rc<DxvkCommandList>&      cmd,
+          VkBuffer                  srcBuffer,
+          VkBuffer                  dstBuffer,
+    const VkBufferCopy&             region) {
+    if (m_srcBuffer != srcBuffer
+     || m_dstBuffer != dstBuffer
+     || m_regions.size() == MaxRegions) {
+      this->recordCommands(cmd);
+      
+      m_srcBuffer = srcBuffer;
+      m_dstBuffer = dstBuffer;
+    }
+    
+    // Sequential uploads through the staging buffer often
+    // produce adjacent regions, which we can merge
+    if (!m_regions.empty()) {
+      VkBufferCopy& last = m_regions.back();
+      
+      if (last.srcOffset + last.size == region.srcOffset
+       && last.dstOffset + last.size == region.dstOffset) {
+        last.size += region.size;
+        return;
+      }
+    }
+    
+    m_regions.push_back(region);
+  }
+  
+  
+  void DxvkBufferCopyBatch::recordCommands(
+    const Rc<DxvkCommandList>&      cmd) {
+    if (m_regions.empty())
+      return;
+    
+    cmd->cmdCopyBuffer(
+      m_srcBuffer, m_dstBuffer,
+      m_regions.size(),
+      m_regions.data());
+    
+    m_regions.clear();
+  }
+  
+}
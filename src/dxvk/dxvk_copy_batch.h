@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+
+#include "dxvk_cmdlist.h"
+
+namespace dxvk {
+  
+  /**
+   * \brief Buffer copy batch
+   * 
+   * Accumulates buffer copies so that consecutive copies
+   * between the same pair of buffers can be recorded with
+   * a single copy command. Since buffers may share backing
+   * storage, copies are grouped by Vulkan buffer handle.
+   * 
+   * Copies are only ordered against other commands via the
+   * barrier set, so pending copies must be recorded before
+   * any barriers are. Regions recorded in the same command
+   * must not overlap, which is guaranteed as long as the
+   * caller checks for hazards before adding a copy.
+   */
+  class DxvkBufferCopyBatch {
+    
+  public:
+    
+    /// Maximum number of regions per copy command
+    constexpr static size_t MaxRegions = 256;
+    
+    DxvkBufferCopyBatch();
+    ~DxvkBufferCopyBatch();
+    
+    /**
+     * \brief Adds a buffer copy
+     * 
+     * If the source or destination buffer differs from the
+     * ones used by pending copies, or if the batch is full,
+     * pending copies will be recorded first.
+     * \param [in] cmd Command list
+     * \param [in] srcBuffer Source buffer handle
+     * \param [in] dstBuffer Destination buffer handle
+     * \param [in] region Copy region
+     */
+    void copyBuffer(
+      const Rc<DxvkCommandList>&      cmd,
+            VkBuffer                  srcBuffer,
+            VkBuffer                  dstBuffer,
+      const VkBufferCopy&             region);
+    
+    /**
+     * \brief Records pending copies
+     * 
+     * Must be called before recording any
+     * barriers into the command list.
+     * \param [in] cmd Command list
+     */
+    void recordCommands(
+      const Rc<DxvkCommandList>&      cmd);
+    
+  private:
+    
+    VkBuffer                  m_srcBuffer = VK_NULL_HANDLE;
+    VkBuffer                  m_dstBuffer = VK_NULL_HANDLE;
+    
+    std::vector<VkBufferCopy> m_regions;
+    
+  };
+  
+}
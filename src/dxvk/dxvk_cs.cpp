@@ -1,4 +1,5 @@
 #include "dxvk_cs.h"
+#include "dxvk_device.h"
 
 namespace dxvk {
   
@@ -97,8 +98,11 @@ namespace dxvk {
   }
   
   
-  DxvkCsThread::DxvkCsThread(const Rc<DxvkContext>& context)
-  : m_context(context), m_thread([this] { threadFunc(); }) {
+  DxvkCsThread::DxvkCsThread(
+    const Rc<DxvkDevice>&       device,
+    const Rc<DxvkContext>&      context)
+  : m_device(device), m_context(context),
+    m_thread([this] { threadFunc(); }) {
     
   }
   
@@ -159,8 +163,16 @@ namespace dxvk {
         }
       }
       
-      if (chunk)
+      if (chunk) {
+        TraceZone zone("CS chunk");
+        
+        auto t0 = std::chrono::high_resolution_clock::now();
         chunk->executeAll(m_context.ptr());
+        auto t1 = std::chrono::high_resolution_clock::now();
+        
+        m_device->addStatCtr(DxvkStatCounter::CsBusyTime,
+          std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+      }
     }
   }
   
@@ -385,7 +385,9 @@ namespace dxvk {
     
   public:
     
-    DxvkCsThread(const Rc<DxvkContext>& context);
+    DxvkCsThread(
+      const Rc<DxvkDevice>&       device,
+      const Rc<DxvkContext>&      context);
     ~DxvkCsThread();
     
     /**
@@ -409,6 +411,7 @@ namespace dxvk {
     
   private:
     
+    const Rc<DxvkDevice>        m_device;
     const Rc<DxvkContext>       m_context;
     
     std::atomic<bool>           m_stopped = { false };
@@ -17,6 +17,7 @@ namespace dxvk {
     m_features          (features),
     m_properties        (adapter->deviceProperties()),
     m_memory            (new DxvkMemoryAllocator    (this)),
+    m_bufferArena       (this),
     m_renderPassPool    (new DxvkRenderPassPool     (vkd)),
     m_pipelineManager   (new DxvkPipelineManager    (this, m_renderPassPool.ptr())),
     m_metaClearObjects  (new DxvkMetaClearObjects   (vkd)),
@@ -28,6 +29,7 @@ namespace dxvk {
     m_submissionQueue   (this) {
     m_graphicsQueue.queueFamily = m_adapter->graphicsQueueFamily();
     m_presentQueue.queueFamily  = m_adapter->presentQueueFamily();
+    m_transferQueue.queueFamily = m_adapter->transferQueueFamily();
     
     m_vkd->vkGetDeviceQueue(m_vkd->device(),
       m_graphicsQueue.queueFamily, 0,
@@ -36,6 +38,10 @@ namespace dxvk {
     m_vkd->vkGetDeviceQueue(m_vkd->device(),
       m_presentQueue.queueFamily, 0,
       &m_presentQueue.queueHandle);
+    
+    m_vkd->vkGetDeviceQueue(m_vkd->device(),
+      m_transferQueue.queueFamily, 0,
+      &m_transferQueue.queueHandle);
   }
   
   
@@ -125,6 +131,18 @@ namespace dxvk {
     
     return cmdList;
   }
+  
+  
+  Rc<DxvkCommandList> DxvkDevice::createTransferCommandList() {
+    Rc<DxvkCommandList> cmdList = m_recycledTransferLists.retrieveObject();
+    
+    if (cmdList == nullptr) {
+      cmdList = new DxvkCommandList(this,
+        m_transferQueue.queueFamily);
+    }
+    
+    return cmdList;
+  }
 
 
   Rc<DxvkDescriptorPool> DxvkDevice::createDescriptorPool() {
@@ -148,6 +166,11 @@ namespace dxvk {
   }
   
   
+  Rc<DxvkTransferContext> DxvkDevice::createTransferContext() {
+    return new DxvkTransferContext(this);
+  }
+  
+  
   Rc<DxvkFramebuffer> DxvkDevice::createFramebuffer(
     const DxvkRenderTargets& renderTargets) {
     const DxvkFramebufferSize defaultSize = {
@@ -166,7 +189,10 @@ namespace dxvk {
   Rc<DxvkBuffer> DxvkDevice::createBuffer(
     const DxvkBufferCreateInfo& createInfo,
           VkMemoryPropertyFlags memoryType) {
-    return new DxvkBuffer(this, createInfo, *m_memory, memoryType);
+    DxvkBufferArena* arena = DxvkBufferArena::isEligible(createInfo, memoryType)
+      ? &m_bufferArena : nullptr;
+    
+    return new DxvkBuffer(this, createInfo, *m_memory, arena, memoryType);
   }
   
   
@@ -213,12 +239,17 @@ namespace dxvk {
   DxvkStatCounters DxvkDevice::getStatCounters() {
     DxvkMemoryStats mem = m_memory->getMemoryStats();
     DxvkPipelineCount pipe = m_pipelineManager->getPipelineCount();
+    DxvkSubmissionStats queue = m_submissionQueue.getStats();
     
     DxvkStatCounters result;
     result.setCtr(DxvkStatCounter::MemoryAllocated,   mem.memoryAllocated);
     result.setCtr(DxvkStatCounter::MemoryUsed,        mem.memoryUsed);
+    result.setCtr(DxvkStatCounter::MemorySpare,       mem.memorySpare);
     result.setCtr(DxvkStatCounter::PipeCountGraphics, pipe.numGraphicsPipelines);
     result.setCtr(DxvkStatCounter::PipeCountCompute,  pipe.numComputePipelines);
+    result.setCtr(DxvkStatCounter::QueueRetireCount,  queue.retireCount);
+    result.setCtr(DxvkStatCounter::QueueSignalTime,   queue.signalTimeUs);
+    result.setCtr(DxvkStatCounter::QueueRetireTime,   queue.retireTimeUs);
     
     std::lock_guard<sync::Spinlock> lock(m_statLock);
     result.merge(m_statCounters);
@@ -226,6 +257,24 @@ namespace dxvk {
   }
 
 
+  void DxvkDevice::addStatCtr(DxvkStatCounter ctr, uint64_t val) {
+    std::lock_guard<sync::Spinlock> lock(m_statLock);
+    m_statCounters.addCtr(ctr, val);
+  }
+
+
+  void DxvkDevice::registerTrimBuffer(DxvkBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(m_trimLock);
+    m_trimBuffers.insert(buffer);
+  }
+
+
+  void DxvkDevice::unregisterTrimBuffer(DxvkBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(m_trimLock);
+    m_trimBuffers.erase(buffer);
+  }
+
+
   uint32_t DxvkDevice::getCurrentFrameId() const {
     return m_statCounters.getCtr(DxvkStatCounter::QueuePresentCount);
   }
@@ -241,17 +290,35 @@ namespace dxvk {
   }
   
   
+  void DxvkDevice::setSpecConstant(
+          DxvkSpecConstantId      specId,
+          uint32_t                value) {
+    m_pipelineManager->setSpecConstant(specId, value);
+  }
+  
+  
   VkResult DxvkDevice::presentImage(
     const Rc<vk::Presenter>&        presenter,
           VkSemaphore               semaphore) {
-    std::lock_guard<std::mutex> queueLock(m_submissionLock);
-    VkResult status = presenter->presentImage(semaphore);
-
-    if (status != VK_SUCCESS)
-      return status;
+    VkResult status;
+    uint64_t frameId;
+    
+    { std::lock_guard<std::mutex> queueLock(m_submissionLock);
+      status = presenter->presentImage(semaphore);
+      
+      if (status != VK_SUCCESS)
+        return status;
+      
+      std::lock_guard<sync::Spinlock> statLock(m_statLock);
+      m_statCounters.addCtr(DxvkStatCounter::QueuePresentCount, 1);
+      frameId = m_statCounters.getCtr(DxvkStatCounter::QueuePresentCount);
+    }
+    
+    // Periodically release backing storage of buffers
+    // that no longer need as many slices as they used to
+    if (!(frameId % BufferTrimInterval))
+      this->trimBuffers();
     
-    std::lock_guard<sync::Spinlock> statLock(m_statLock);
-    m_statCounters.addCtr(DxvkStatCounter::QueuePresentCount, 1);
     return status;
   }
 
@@ -260,23 +327,68 @@ namespace dxvk {
     const Rc<DxvkCommandList>&      commandList,
           VkSemaphore               waitSync,
           VkSemaphore               wakeSync) {
+    { std::lock_guard<sync::Spinlock> lock(m_pendingLock);
+      m_pendingSubmissions.push_back({ commandList, waitSync, wakeSync });
+    }
+    
+    std::vector<DxvkPendingSubmission> batch;
     VkResult status;
     
-    { // Queue submissions are not thread safe
+    { // Queue submissions are not thread safe. Whichever thread
+      // acquires the lock first submits all command lists that
+      // are pending at that point, including ours, which allows
+      // us to submit concurrent flushes with a single call.
       std::lock_guard<std::mutex> queueLock(m_submissionLock);
-      std::lock_guard<sync::Spinlock> statLock(m_statLock);
       
-      m_statCounters.merge(commandList->statCounters());
-      m_statCounters.addCtr(DxvkStatCounter::QueueSubmitCount, 1);
+      { std::lock_guard<sync::Spinlock> lock(m_pendingLock);
+        std::swap(batch, m_pendingSubmissions);
+      }
+      
+      if (batch.size() == 0)
+        return;
+      
+      // Only the last command list's fence will be signaled,
+      // so all other command lists have to wait for that one.
+      VkFence fence = batch.back().cmdList->fence();
+      
+      for (const auto& entry : batch) {
+        entry.cmdList->setSubmitFence(fence);
+        
+        m_submitInfos.push_back(entry.cmdList->prepareSubmit(
+          entry.waitSync, entry.wakeSync));
+      }
+      
+      auto t0 = std::chrono::high_resolution_clock::now();
       
-      status = commandList->submit(
+      status = m_vkd->vkQueueSubmit(
         m_graphicsQueue.queueHandle,
-        waitSync, wakeSync);
+        m_submitInfos.size(),
+        m_submitInfos.data(), fence);
+      
+      auto t1 = std::chrono::high_resolution_clock::now();
+      
+      if (Tracer::isEnabled())
+        Tracer::recordCpuZone("Queue submit", t0, t1);
+      
+      m_submitInfos.clear();
+      
+      std::lock_guard<sync::Spinlock> statLock(m_statLock);
+      
+      for (const auto& entry : batch)
+        m_statCounters.merge(entry.cmdList->statCounters());
+      
+      m_statCounters.addCtr(DxvkStatCounter::QueueSubmitCount, 1);
+      m_statCounters.addCtr(DxvkStatCounter::QueueCmdListCount, batch.size());
+      m_statCounters.addCtr(DxvkStatCounter::QueueSubmitTime,
+        std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
     }
     
     if (status == VK_SUCCESS) {
-      // Add this to the set of running submissions
-      m_submissionQueue.submit(commandList);
+      // Add this to the set of running submissions. This may
+      // block if too many command lists are in flight, so it
+      // must not happen while the queue is locked.
+      for (const auto& entry : batch)
+        m_submissionQueue.submit(entry.cmdList);
     } else {
       Logger::err(str::format(
         "DxvkDevice: Command buffer submission failed: ",
@@ -285,6 +397,49 @@ namespace dxvk {
   }
   
   
+  VkSemaphore DxvkDevice::submitTransferCommandList(
+    const Rc<DxvkCommandList>&      commandList) {
+    VkSemaphoreCreateInfo semaphoreInfo;
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = nullptr;
+    semaphoreInfo.flags = 0;
+    
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    
+    if (m_vkd->vkCreateSemaphore(m_vkd->device(), &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
+      throw DxvkError("DxvkDevice: Failed to create semaphore");
+    
+    VkResult status;
+    
+    { std::lock_guard<std::mutex> queueLock(m_submissionLock);
+      
+      VkSubmitInfo submitInfo = commandList->prepareSubmit(
+        VK_NULL_HANDLE, semaphore);
+      
+      status = m_vkd->vkQueueSubmit(
+        m_transferQueue.queueHandle, 1,
+        &submitInfo, commandList->fence());
+      
+      std::lock_guard<sync::Spinlock> statLock(m_statLock);
+      m_statCounters.merge(commandList->statCounters());
+      m_statCounters.addCtr(DxvkStatCounter::QueueSubmitCount, 1);
+      m_statCounters.addCtr(DxvkStatCounter::QueueCmdListCount, 1);
+    }
+    
+    if (status != VK_SUCCESS) {
+      Logger::err(str::format(
+        "DxvkDevice: Transfer command buffer submission failed: ",
+        status));
+      
+      m_vkd->vkDestroySemaphore(m_vkd->device(), semaphore, nullptr);
+      return VK_NULL_HANDLE;
+    }
+    
+    m_submissionQueue.submit(commandList);
+    return semaphore;
+  }
+  
+  
   void DxvkDevice::waitForIdle() {
     if (m_vkd->vkDeviceWaitIdle(m_vkd->device()) != VK_SUCCESS)
       Logger::err("DxvkDevice: waitForIdle: Operation failed");
@@ -292,10 +447,25 @@ namespace dxvk {
   
   
   void DxvkDevice::recycleCommandList(const Rc<DxvkCommandList>& cmdList) {
-    m_recycledCommandLists.returnObject(cmdList);
+    if (cmdList->queueFamily() == m_graphicsQueue.queueFamily)
+      m_recycledCommandLists.returnObject(cmdList);
+    else
+      m_recycledTransferLists.returnObject(cmdList);
   }
   
 
+  void DxvkDevice::trimBuffers() {
+    std::lock_guard<std::mutex> lock(m_trimLock);
+    
+    for (auto iter = m_trimBuffers.begin(); iter != m_trimBuffers.end(); ) {
+      if (!(*iter)->trim())
+        iter = m_trimBuffers.erase(iter);
+      else
+        iter++;
+    }
+  }
+  
+  
   void DxvkDevice::recycleDescriptorPool(const Rc<DxvkDescriptorPool>& pool) {
     m_recycledDescriptorPools.returnObject(pool);
   }
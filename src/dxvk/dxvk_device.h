@@ -1,7 +1,10 @@
 #pragma once
 
+#include <unordered_set>
+
 #include "dxvk_adapter.h"
 #include "dxvk_buffer.h"
+#include "dxvk_buffer_arena.h"
 #include "dxvk_compute.h"
 #include "dxvk_constant_state.h"
 #include "dxvk_context.h"
@@ -20,6 +23,7 @@
 #include "dxvk_sampler.h"
 #include "dxvk_shader.h"
 #include "dxvk_stats.h"
+#include "dxvk_transfer.h"
 #include "dxvk_unbound.h"
 
 #include "../vulkan/vulkan_presenter.h"
@@ -47,6 +51,19 @@ namespace dxvk {
     VkQueue   queueHandle = VK_NULL_HANDLE;
   };
   
+  /**
+   * \brief Pending submission
+   * 
+   * Command list that has been passed to the
+   * device for submission, along with the
+   * semaphores to wait on and to signal.
+   */
+  struct DxvkPendingSubmission {
+    Rc<DxvkCommandList> cmdList;
+    VkSemaphore         waitSync;
+    VkSemaphore         wakeSync;
+  };
+  
   /**
    * \brief DXVK device
    * 
@@ -61,6 +78,7 @@ namespace dxvk {
     friend class DxvkDescriptorPoolTracker;
     
     constexpr static VkDeviceSize DefaultStagingBufferSize = 4 * 1024 * 1024;
+    constexpr static uint32_t     BufferTrimInterval       = 60;
   public:
     
     DxvkDevice(
@@ -115,6 +133,26 @@ namespace dxvk {
       return m_graphicsQueue;
     }
     
+    /**
+     * \brief Transfer queue properties
+     * 
+     * Same as the graphics queue if the device
+     * has no dedicated transfer queue family.
+     * \returns Transfer queue info
+     */
+    DxvkDeviceQueue transferQueue() const {
+      return m_transferQueue;
+    }
+    
+    /**
+     * \brief Checks for a dedicated transfer queue
+     * \returns \c true if uploads can be performed
+     *          on a queue other than the graphics queue
+     */
+    bool hasDedicatedTransferQueue() const {
+      return m_transferQueue.queueFamily != m_graphicsQueue.queueFamily;
+    }
+    
     /**
      * \brief The adapter
      * 
@@ -183,6 +221,15 @@ namespace dxvk {
      */
     Rc<DxvkCommandList> createCommandList();
     
+    /**
+     * \brief Creates a transfer command list
+     * 
+     * The command list can only be submitted
+     * with \ref submitTransferCommandList.
+     * \returns The command list
+     */
+    Rc<DxvkCommandList> createTransferCommandList();
+    
     /**
      * \brief Creates a descriptor pool
      * 
@@ -202,6 +249,15 @@ namespace dxvk {
      */
     Rc<DxvkContext> createContext();
     
+    /**
+     * \brief Creates a transfer context
+     * 
+     * Only useful if the device has a dedicated
+     * transfer queue, see \ref hasDedicatedTransferQueue.
+     * \returns The transfer context
+     */
+    Rc<DxvkTransferContext> createTransferContext();
+    
     /**
      * \brief Creates framebuffer for a set of render targets
      * 
@@ -292,6 +348,36 @@ namespace dxvk {
      */
     DxvkStatCounters getStatCounters();
 
+    /**
+     * \brief Increments a stat counter
+     * 
+     * Used to report statistics that are not tied
+     * to a command list, such as time spent waiting
+     * on the CS thread. Thread-safe.
+     * \param [in] ctr Counter to increment
+     * \param [in] val Number to add to counter value
+     */
+    void addStatCtr(DxvkStatCounter ctr, uint64_t val);
+
+    /**
+     * \brief Registers a buffer for trimming
+     * 
+     * Called by buffers that allocated additional
+     * backing storage for renamed slices, so that
+     * unused storage can be released periodically.
+     * \param [in] buffer The buffer
+     */
+    void registerTrimBuffer(DxvkBuffer* buffer);
+
+    /**
+     * \brief Unregisters a buffer from trimming
+     * 
+     * Must be called when a registered buffer
+     * gets destroyed.
+     * \param [in] buffer The buffer
+     */
+    void unregisterTrimBuffer(DxvkBuffer* buffer);
+
     /**
      * \brief Retreves current frame ID
      * \returns Current frame ID
@@ -314,6 +400,19 @@ namespace dxvk {
     void registerShader(
       const Rc<DxvkShader>&         shader);
     
+    /**
+     * \brief Sets device spec constant value
+     * 
+     * Used for shader behaviour that is selected by the
+     * client API rather than the pipeline state. Must
+     * be called before any shaders are registered.
+     * \param [in] specId Spec constant ID
+     * \param [in] value Spec constant value
+     */
+    void setSpecConstant(
+            DxvkSpecConstantId      specId,
+            uint32_t                value);
+    
     /**
      * \brief Presents a swap chain image
      * 
@@ -329,7 +428,11 @@ namespace dxvk {
     /**
      * \brief Submits a command list
      * 
-     * Synchronization arguments are optional. 
+     * Synchronization arguments are optional. If multiple
+     * threads submit command lists at the same time, they
+     * will be combined into a single \c vkQueueSubmit call.
+     * In any case, the command list will have been submitted
+     * to the Vulkan queue when this method returns.
      * \param [in] commandList The command list to submit
      * \param [in] waitSync (Optional) Semaphore to wait on
      * \param [in] wakeSync (Optional) Semaphore to notify
@@ -340,6 +443,20 @@ namespace dxvk {
             VkSemaphore               waitSync,
             VkSemaphore               wakeSync);
     
+    /**
+     * \brief Submits a command list to the transfer queue
+     * 
+     * Returns a semaphore that is signaled when the command
+     * list completes. The graphics command list that records
+     * the matching acquire barriers must wait on it, and
+     * takes ownership of it via \c addWaitSemaphore.
+     * \param [in] commandList The command list to submit
+     * \returns Semaphore, or \c VK_NULL_HANDLE if the
+     *    submission failed
+     */
+    VkSemaphore submitTransferCommandList(
+      const Rc<DxvkCommandList>&      commandList);
+    
     /**
      * \brief Locks submission queue
      * 
@@ -372,6 +489,17 @@ namespace dxvk {
       return m_submissionQueue.pendingSubmissions();
     }
     
+    /**
+     * \brief Average GPU latency
+     * 
+     * Time it takes for a submission to complete
+     * on the GPU. Can be used for frame pacing.
+     * \returns GPU latency, in microseconds
+     */
+    std::chrono::microseconds gpuLatency() const {
+      return m_submissionQueue.gpuLatency();
+    }
+    
     /**
      * \brief Waits until the device becomes idle
      * 
@@ -395,6 +523,11 @@ namespace dxvk {
     VkPhysicalDeviceProperties  m_properties;
     
     Rc<DxvkMemoryAllocator>     m_memory;
+    
+    std::mutex                  m_trimLock;
+    std::unordered_set<DxvkBuffer*> m_trimBuffers;
+    
+    DxvkBufferArena             m_bufferArena;
     Rc<DxvkRenderPassPool>      m_renderPassPool;
     Rc<DxvkPipelineManager>     m_pipelineManager;
 
@@ -410,10 +543,17 @@ namespace dxvk {
     DxvkStatCounters            m_statCounters;
     
     std::mutex                  m_submissionLock;
+    
+    sync::Spinlock              m_pendingLock;
+    std::vector<DxvkPendingSubmission> m_pendingSubmissions;
+    std::vector<VkSubmitInfo>          m_submitInfos;
+    
     DxvkDeviceQueue             m_graphicsQueue;
     DxvkDeviceQueue             m_presentQueue;
+    DxvkDeviceQueue             m_transferQueue;
     
     DxvkRecycler<DxvkCommandList,    16> m_recycledCommandLists;
+    DxvkRecycler<DxvkCommandList,     4> m_recycledTransferLists;
     DxvkRecycler<DxvkDescriptorPool, 16> m_recycledDescriptorPools;
     DxvkRecycler<DxvkStagingBuffer,   4> m_recycledStagingBuffers;
     
@@ -425,6 +565,8 @@ namespace dxvk {
     void recycleDescriptorPool(
       const Rc<DxvkDescriptorPool>& pool);
     
+    void trimBuffers();
+    
     /**
      * \brief Dummy buffer handle
      * \returns Use for unbound vertex buffers.
@@ -1,4 +1,6 @@
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstring>
 
 #include "dxvk_device.h"
@@ -37,6 +39,77 @@ namespace dxvk {
   }
   
   
+  /**
+   * \brief Byte range of the pipeline state vector
+   * 
+   * Maps a range of the state vector to the part it belongs
+   * to. This relies on the members of each part being contiguous.
+   */
+  struct DxvkGraphicsPipelineStateRange {
+    size_t                        begin;
+    size_t                        end;
+    DxvkGraphicsPipelineStatePart part;
+  };
+  
+  
+  static const std::array<DxvkGraphicsPipelineStateRange, 6> g_stateRanges = {{
+    { 0,
+      offsetof(DxvkGraphicsPipelineStateInfo, iaPrimitiveTopology),
+      DxvkGraphicsPipelineStatePart::Other },
+    { offsetof(DxvkGraphicsPipelineStateInfo, iaPrimitiveTopology),
+      offsetof(DxvkGraphicsPipelineStateInfo, rsDepthClipEnable),
+      DxvkGraphicsPipelineStatePart::VertexInput },
+    { offsetof(DxvkGraphicsPipelineStateInfo, rsDepthClipEnable),
+      offsetof(DxvkGraphicsPipelineStateInfo, msSampleCount),
+      DxvkGraphicsPipelineStatePart::Other },
+    { offsetof(DxvkGraphicsPipelineStateInfo, msSampleCount),
+      offsetof(DxvkGraphicsPipelineStateInfo, dsEnableDepthTest),
+      DxvkGraphicsPipelineStatePart::FragmentOutput },
+    { offsetof(DxvkGraphicsPipelineStateInfo, dsEnableDepthTest),
+      offsetof(DxvkGraphicsPipelineStateInfo, omEnableLogicOp),
+      DxvkGraphicsPipelineStatePart::Other },
+    { offsetof(DxvkGraphicsPipelineStateInfo, omEnableLogicOp),
+      sizeof(DxvkGraphicsPipelineStateInfo),
+      DxvkGraphicsPipelineStatePart::FragmentOutput },
+  }};
+  
+  
+  DxvkGraphicsPipelineStateParts DxvkGraphicsPipelineStateInfo::diff(
+    const DxvkGraphicsPipelineStateInfo& other) const {
+    auto a = reinterpret_cast<const char*>(this);
+    auto b = reinterpret_cast<const char*>(&other);
+    
+    DxvkGraphicsPipelineStateParts result;
+    
+    for (const auto& range : g_stateRanges) {
+      if (!result.test(range.part)
+       && std::memcmp(a + range.begin, b + range.begin, range.end - range.begin))
+        result.set(range.part);
+    }
+    
+    return result;
+  }
+  
+  
+  size_t DxvkGraphicsPipelineStateInfo::hashExcept(
+          DxvkGraphicsPipelineStatePart part) const {
+    auto data = reinterpret_cast<const uint8_t*>(this);
+    
+    // FNV-1a over all bytes that do not belong to the given part
+    size_t result = 0xcbf29ce484222325ull;
+    
+    for (const auto& range : g_stateRanges) {
+      if (range.part == part)
+        continue;
+      
+      for (size_t i = range.begin; i < range.end; i++)
+        result = (result ^ data[i]) * 0x100000001b3ull;
+    }
+    
+    return result;
+  }
+  
+  
   DxvkGraphicsPipeline::DxvkGraphicsPipeline(
           DxvkPipelineManager*      pipeMgr,
     const Rc<DxvkShader>&           vs,
@@ -77,7 +150,7 @@ namespace dxvk {
     m_vsIn  = vs != nullptr ? vs->interfaceSlots().inputSlots  : 0;
     m_fsOut = fs != nullptr ? fs->interfaceSlots().outputSlots : 0;
 
-    if (gs != nullptr && gs->hasCapability(spv::CapabilityTransformFeedback))
+    if (gs != nullptr && gs->flags().test(DxvkShaderFlag::HasTransformFeedback))
       m_flags.set(DxvkGraphicsPipelineFlag::HasTransformFeedback);
     
     VkShaderStageFlags stoStages = m_layout->getStorageDescriptorStages();
@@ -88,7 +161,7 @@ namespace dxvk {
     if (stoStages & ~VK_SHADER_STAGE_FRAGMENT_BIT)
       m_flags.set(DxvkGraphicsPipelineFlag::HasVsStorageDescriptors);
     
-    m_common.msSampleShadingEnable = fs != nullptr && fs->hasCapability(spv::CapabilitySampleRateShading);
+    m_common.msSampleShadingEnable = fs != nullptr && fs->flags().test(DxvkShaderFlag::HasSampleRateShading);
     m_common.msSampleShadingFactor = 1.0f;
   }
   
@@ -120,7 +193,8 @@ namespace dxvk {
 
   VkPipeline DxvkGraphicsPipeline::getPipelineHandle(
     const DxvkGraphicsPipelineStateInfo& state,
-    const DxvkRenderPass&                renderPass) {
+    const DxvkRenderPass&                renderPass,
+          DxvkStatCounters*              stats) {
     VkRenderPass renderPassHandle = renderPass.getDefaultHandle();
     
     VkPipeline newPipelineHandle = VK_NULL_HANDLE;
@@ -138,13 +212,40 @@ namespace dxvk {
         return VK_NULL_HANDLE;
       
       // If no pipeline instance exists with the given state
-      // vector, create a new one and add it to the list.
-      newPipelineHandle = this->compilePipeline(state, renderPassHandle, m_basePipeline);
+      // vector, create a new one and add it to the list. If
+      // an existing instance only differs in its vertex input
+      // or fragment output state, use it as the base pipeline
+      // so that drivers can reuse the compiled shader stages.
+      DxvkGraphicsPipelineStatePart part = DxvkGraphicsPipelineStatePart::Other;
+      VkPipeline baseHandle = m_basePipeline;
+      
+      auto base = this->findBaseInstance(state, renderPassHandle, part);
+      
+      if (base != nullptr)
+        baseHandle = base->pipeline();
+      
+      auto t0 = std::chrono::high_resolution_clock::now();
+      newPipelineHandle = this->compilePipeline(state, renderPassHandle, baseHandle, part);
+      auto t1 = std::chrono::high_resolution_clock::now();
+      
+      if (stats != nullptr) {
+        stats->addCtr(DxvkStatCounter::PipeCompileCount, 1);
+        stats->addCtr(DxvkStatCounter::PipeCompileTime,
+          std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+      }
 
       // Add new pipeline to the set
       m_pipelines.emplace_back(state, renderPassHandle, newPipelineHandle);
       m_pipeMgr->m_numGraphicsPipelines += 1;
       
+      if (newPipelineHandle != VK_NULL_HANDLE) {
+        for (uint32_t i = 0; i < m_variantIndex.size(); i++) {
+          m_variantIndex[i].insert({
+            this->getVariantKey(state, renderPassHandle, DxvkGraphicsPipelineStatePart(i)),
+            m_pipelines.size() - 1 });
+        }
+      }
+      
       if (!m_basePipeline && newPipelineHandle)
         m_basePipeline = newPipelineHandle;
     }
@@ -168,10 +269,52 @@ namespace dxvk {
   }
   
   
+  const DxvkGraphicsPipelineInstance* DxvkGraphicsPipeline::findBaseInstance(
+    const DxvkGraphicsPipelineStateInfo& state,
+          VkRenderPass                   renderPass,
+          DxvkGraphicsPipelineStatePart& part) const {
+    for (uint32_t i = 0; i < m_variantIndex.size(); i++) {
+      auto candidatePart = DxvkGraphicsPipelineStatePart(i);
+      
+      auto entry = m_variantIndex[i].find(
+        this->getVariantKey(state, renderPass, candidatePart));
+      
+      if (entry == m_variantIndex[i].end())
+        continue;
+      
+      // The key is only a hash, so verify that
+      // the instance is actually a valid base
+      const DxvkGraphicsPipelineInstance& instance = m_pipelines[entry->second];
+      
+      if (instance.renderPass() == renderPass
+       && instance.state().diff(state) == candidatePart) {
+        part = candidatePart;
+        return &instance;
+      }
+    }
+    
+    return nullptr;
+  }
+  
+  
+  size_t DxvkGraphicsPipeline::getVariantKey(
+    const DxvkGraphicsPipelineStateInfo& state,
+          VkRenderPass                   renderPass,
+          DxvkGraphicsPipelineStatePart  part) const {
+    DxvkHashState key;
+    key.add(std::hash<VkRenderPass>()(renderPass));
+    key.add(state.hashExcept(part));
+    return key;
+  }
+  
+  
   VkPipeline DxvkGraphicsPipeline::compilePipeline(
     const DxvkGraphicsPipelineStateInfo& state,
           VkRenderPass                   renderPass,
-          VkPipeline                     baseHandle) const {
+          VkPipeline                     baseHandle,
+          DxvkGraphicsPipelineStatePart  part) const {
+    TraceZone zone("Compile pipeline");
+    
     if (Logger::logLevel() <= LogLevel::Debug) {
       Logger::debug("Compiling graphics pipeline...");
       this->logPipelineState(LogLevel::Debug, state);
@@ -203,7 +346,8 @@ namespace dxvk {
     
     // Set up some specialization constants
     DxvkSpecConstantData specData;
-    specData.rasterizerSampleCount = uint32_t(sampleCount);
+    m_pipeMgr->m_specConstants.apply(specData);
+    specData.set(DxvkSpecConstantId::RasterizerSampleCount, uint32_t(sampleCount));
     
     for (uint32_t i = 0; i < MaxNumActiveBindings; i++)
       specData.activeBindings[i] = state.bsBindingMask.isBound(i) ? VK_TRUE : VK_FALSE;
@@ -409,9 +553,11 @@ namespace dxvk {
     info.basePipelineHandle       = baseHandle;
     info.basePipelineIndex        = -1;
     
-    info.flags |= baseHandle == VK_NULL_HANDLE
-      ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT
-      : VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+    // Any pipeline may serve as a base for a later variant
+    info.flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+    
+    if (baseHandle != VK_NULL_HANDLE)
+      info.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
     
     if (tsInfo.patchControlPoints == 0)
       info.pTessellationState = nullptr;
@@ -428,8 +574,10 @@ namespace dxvk {
     }
     
     auto t1 = std::chrono::high_resolution_clock::now();
-    auto td = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-    Logger::debug(str::format("DxvkGraphicsPipeline: Finished in ", td.count(), " ms"));
+    auto td = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+    m_pipeMgr->addCompileTime(part, td.count());
+    
+    Logger::log(LogLevel::Debug, "DxvkGraphicsPipeline: Finished in ", td.count() / 1000, " ms");
     return pipeline;
   }
   
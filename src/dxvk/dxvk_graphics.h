@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <mutex>
+#include <unordered_map>
 
 #include "dxvk_bind_mask.h"
 #include "dxvk_constant_state.h"
@@ -28,6 +30,24 @@ namespace dxvk {
   using DxvkGraphicsPipelineFlags = Flags<DxvkGraphicsPipelineFlag>;
 
 
+  /**
+   * \brief Pipeline state parts
+   * 
+   * Groups of pipeline state that can vary independently
+   * of the shaders. Used to find a suitable base pipeline
+   * when a new pipeline only differs from an existing one
+   * in its vertex input or fragment output state, and to
+   * measure compile times for each kind of variant.
+   */
+  enum class DxvkGraphicsPipelineStatePart : uint32_t {
+    VertexInput     = 0,  ///< Input assembly and vertex input state
+    FragmentOutput  = 1,  ///< Multisample and color blend state
+    Other           = 2,  ///< Rasterizer, depth-stencil and bindings
+  };
+
+  using DxvkGraphicsPipelineStateParts = Flags<DxvkGraphicsPipelineStatePart>;
+
+
   /**
    * \brief Graphics pipeline state info
    * 
@@ -47,6 +67,24 @@ namespace dxvk {
     bool operator == (const DxvkGraphicsPipelineStateInfo& other) const;
     bool operator != (const DxvkGraphicsPipelineStateInfo& other) const;
 
+    /**
+     * \brief Computes which parts of the state differ
+     * 
+     * \param [in] other State vector to compare with
+     * \returns Parts that are not identical
+     */
+    DxvkGraphicsPipelineStateParts diff(
+      const DxvkGraphicsPipelineStateInfo& other) const;
+
+    /**
+     * \brief Hashes all state except for the given part
+     * 
+     * \param [in] part State part to ignore
+     * \returns Hash of the remaining state
+     */
+    size_t hashExcept(
+            DxvkGraphicsPipelineStatePart part) const;
+
     bool useDynamicStencilRef() const {
       return dsEnableStencilTest;
     }
@@ -161,6 +199,22 @@ namespace dxvk {
       return m_pipeline;
     }
 
+    /**
+     * \brief Retrieves render pass
+     * \returns The render pass handle
+     */
+    VkRenderPass renderPass() const {
+      return m_renderPass;
+    }
+
+    /**
+     * \brief Retrieves state vector
+     * \returns The pipeline state
+     */
+    const DxvkGraphicsPipelineStateInfo& state() const {
+      return m_stateVector;
+    }
+
   private:
 
     DxvkGraphicsPipelineStateInfo m_stateVector;
@@ -228,11 +282,14 @@ namespace dxvk {
      * state. If necessary, a new pipeline will be created.
      * \param [in] state Pipeline state vector
      * \param [in] renderPass The render pass
+     * \param [in] stats Stat counters to record compile
+     *    time in, or \c nullptr for background compiles
      * \returns Pipeline handle
      */
     VkPipeline getPipelineHandle(
       const DxvkGraphicsPipelineStateInfo&    state,
-      const DxvkRenderPass&                   renderPass);
+      const DxvkRenderPass&                   renderPass,
+            DxvkStatCounters*                 stats);
     
   private:
     
@@ -263,6 +320,10 @@ namespace dxvk {
     alignas(CACHE_LINE_SIZE) sync::Spinlock   m_mutex;
     std::vector<DxvkGraphicsPipelineInstance> m_pipelines;
     
+    // Indices of pipeline instances, keyed by their state with
+    // the vertex input or fragment output part masked out
+    std::array<std::unordered_map<size_t, size_t>, 2> m_variantIndex;
+    
     // Pipeline handles used for derivative pipelines
     VkPipeline m_basePipeline = VK_NULL_HANDLE;
     
@@ -270,10 +331,21 @@ namespace dxvk {
       const DxvkGraphicsPipelineStateInfo& state,
             VkRenderPass                   renderPass) const;
     
+    const DxvkGraphicsPipelineInstance* findBaseInstance(
+      const DxvkGraphicsPipelineStateInfo& state,
+            VkRenderPass                   renderPass,
+            DxvkGraphicsPipelineStatePart& part) const;
+    
+    size_t getVariantKey(
+      const DxvkGraphicsPipelineStateInfo& state,
+            VkRenderPass                   renderPass,
+            DxvkGraphicsPipelineStatePart  part) const;
+    
     VkPipeline compilePipeline(
       const DxvkGraphicsPipelineStateInfo& state,
             VkRenderPass                   renderPass,
-            VkPipeline                     baseHandle) const;
+            VkPipeline                     baseHandle,
+            DxvkGraphicsPipelineStatePart  part) const;
     
     void destroyPipeline(
             VkPipeline                     pipeline) const;
@@ -120,6 +120,12 @@ namespace dxvk {
   
   
   DxvkImage::~DxvkImage() {
+    for (const auto& pair : m_metaFramebuffers)
+      m_vkd->vkDestroyFramebuffer(m_vkd->device(), pair.second, nullptr);
+    
+    for (const auto& pair : m_metaViews)
+      m_vkd->vkDestroyImageView(m_vkd->device(), pair.second, nullptr);
+    
     // This is a bit of a hack to determine whether
     // the image is implementation-handled or not
     if (m_memory.memory() != VK_NULL_HANDLE)
@@ -127,6 +133,92 @@ namespace dxvk {
   }
   
   
+  VkImageView DxvkImage::getMetaView(
+    const DxvkMetaViewKey&      key) {
+    std::lock_guard<std::mutex> lock(m_metaMutex);
+    
+    DxvkMetaViewKey viewKey = key;
+    viewKey.renderPass = VK_NULL_HANDLE;
+    
+    auto entry = m_metaViews.find(viewKey);
+    if (entry != m_metaViews.end())
+      return entry->second;
+    
+    VkImageView view = this->createMetaView(viewKey);
+    m_metaViews.insert({ viewKey, view });
+    return view;
+  }
+  
+  
+  VkFramebuffer DxvkImage::getMetaFramebuffer(
+    const DxvkMetaViewKey&      key,
+          VkRenderPass          renderPass) {
+    DxvkMetaViewKey fbKey = key;
+    fbKey.renderPass = renderPass;
+    
+    VkImageView view = this->getMetaView(key);
+    
+    std::lock_guard<std::mutex> lock(m_metaMutex);
+    
+    auto entry = m_metaFramebuffers.find(fbKey);
+    if (entry != m_metaFramebuffers.end())
+      return entry->second;
+    
+    VkFramebuffer framebuffer = this->createMetaFramebuffer(fbKey, view);
+    m_metaFramebuffers.insert({ fbKey, framebuffer });
+    return framebuffer;
+  }
+  
+  
+  VkImageView DxvkImage::createMetaView(
+    const DxvkMetaViewKey&      key) const {
+    VkImageViewUsageCreateInfoKHR viewUsage;
+    viewUsage.sType           = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO_KHR;
+    viewUsage.pNext           = nullptr;
+    viewUsage.usage           = key.usage;
+    
+    VkImageViewCreateInfo viewInfo;
+    viewInfo.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.pNext            = &viewUsage;
+    viewInfo.flags            = 0;
+    viewInfo.image            = m_image;
+    viewInfo.viewType         = key.type;
+    viewInfo.format           = key.format;
+    viewInfo.components       = {
+      VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+      VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+    viewInfo.subresourceRange = key.subresources;
+    
+    VkImageView result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateImageView(m_vkd->device(), &viewInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("DxvkImage: Failed to create meta image view");
+    return result;
+  }
+  
+  
+  VkFramebuffer DxvkImage::createMetaFramebuffer(
+    const DxvkMetaViewKey&      key,
+          VkImageView           view) const {
+    VkExtent3D extent = this->mipLevelExtent(key.subresources.baseMipLevel);
+    
+    VkFramebufferCreateInfo fboInfo;
+    fboInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fboInfo.pNext           = nullptr;
+    fboInfo.flags           = 0;
+    fboInfo.renderPass      = key.renderPass;
+    fboInfo.attachmentCount = 1;
+    fboInfo.pAttachments    = &view;
+    fboInfo.width           = extent.width;
+    fboInfo.height          = extent.height;
+    fboInfo.layers          = key.subresources.layerCount;
+    
+    VkFramebuffer result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateFramebuffer(m_vkd->device(), &fboInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("DxvkImage: Failed to create meta framebuffer");
+    return result;
+  }
+  
+  
   DxvkImageView::DxvkImageView(
     const Rc<vk::DeviceFn>&         vkd,
     const Rc<DxvkImage>&            image,
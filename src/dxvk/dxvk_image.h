@@ -1,7 +1,11 @@
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "dxvk_descriptor.h"
 #include "dxvk_format.h"
+#include "dxvk_hash.h"
 #include "dxvk_memory.h"
 #include "dxvk_resource.h"
 #include "dxvk_util.h"
@@ -93,6 +97,48 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Meta view key
+   * 
+   * Identifies an image view that is used internally by
+   * meta operations such as copies, resolves and mip map
+   * generation. These views always use identity swizzles.
+   */
+  struct DxvkMetaViewKey {
+    VkImageViewType         type;
+    VkFormat                format;
+    VkImageUsageFlags       usage;
+    VkImageSubresourceRange subresources;
+    VkRenderPass            renderPass = VK_NULL_HANDLE;
+    
+    bool eq(const DxvkMetaViewKey& other) const {
+      return this->type       == other.type
+          && this->format     == other.format
+          && this->usage      == other.usage
+          && this->renderPass == other.renderPass
+          && this->subresources.aspectMask     == other.subresources.aspectMask
+          && this->subresources.baseMipLevel   == other.subresources.baseMipLevel
+          && this->subresources.levelCount     == other.subresources.levelCount
+          && this->subresources.baseArrayLayer == other.subresources.baseArrayLayer
+          && this->subresources.layerCount     == other.subresources.layerCount;
+    }
+    
+    size_t hash() const {
+      DxvkHashState result;
+      result.add(uint32_t(this->type));
+      result.add(uint32_t(this->format));
+      result.add(uint32_t(this->usage));
+      result.add(uint32_t(this->subresources.aspectMask));
+      result.add(uint32_t(this->subresources.baseMipLevel));
+      result.add(uint32_t(this->subresources.levelCount));
+      result.add(uint32_t(this->subresources.baseArrayLayer));
+      result.add(uint32_t(this->subresources.layerCount));
+      result.add(std::hash<VkRenderPass>()(this->renderPass));
+      return result;
+    }
+  };
+  
+  
   /**
    * \brief DXVK image
    * 
@@ -257,6 +303,33 @@ namespace dxvk {
       return result;
     }
     
+    /**
+     * \brief Retrieves an image view for meta operations
+     * 
+     * Creates the view on first use. The view is owned by
+     * the image and remains valid until the image itself
+     * is destroyed, so callers only need to track the image.
+     * \param [in] key View properties
+     * \returns Image view handle
+     */
+    VkImageView getMetaView(
+      const DxvkMetaViewKey&      key);
+    
+    /**
+     * \brief Retrieves a framebuffer for meta operations
+     * 
+     * Creates a framebuffer with a single attachment, which
+     * is the meta view described by the given key. Its size
+     * matches the extent of the first mip level of the view.
+     * Like views, framebuffers are owned by the image.
+     * \param [in] key View properties
+     * \param [in] renderPass Compatible render pass
+     * \returns Framebuffer handle
+     */
+    VkFramebuffer getMetaFramebuffer(
+      const DxvkMetaViewKey&      key,
+            VkRenderPass          renderPass);
+    
   private:
     
     Rc<vk::DeviceFn>      m_vkd;
@@ -267,6 +340,25 @@ namespace dxvk {
 
     std::vector<VkFormat> m_viewFormats;
     
+    std::mutex            m_metaMutex;
+    
+    std::unordered_map<
+      DxvkMetaViewKey,
+      VkImageView,
+      DxvkHash, DxvkEq> m_metaViews;
+    
+    std::unordered_map<
+      DxvkMetaViewKey,
+      VkFramebuffer,
+      DxvkHash, DxvkEq> m_metaFramebuffers;
+    
+    VkImageView createMetaView(
+      const DxvkMetaViewKey&      key) const;
+    
+    VkFramebuffer createMetaFramebuffer(
+      const DxvkMetaViewKey&      key,
+            VkImageView           view) const;
+    
   };
   
   
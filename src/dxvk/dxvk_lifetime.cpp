@@ -2,14 +2,36 @@
 
 namespace dxvk {
   
-  DxvkLifetimeTracker:: DxvkLifetimeTracker() { }
+  std::atomic<uint64_t> DxvkLifetimeTracker::s_trackingId = { 0ull };
+  
+  
+  DxvkLifetimeTracker::DxvkLifetimeTracker()
+  : m_trackingId(allocTrackingId()) { }
+  
+  
   DxvkLifetimeTracker::~DxvkLifetimeTracker() { }
   
   
-  void DxvkLifetimeTracker::reset() {
+  void DxvkLifetimeTracker::notify() {
     for (const auto& resource : m_resources)
       resource->release();
+    
+    m_notified = true;
+  }
+  
+  
+  void DxvkLifetimeTracker::reset() {
+    if (!m_notified) {
+      for (const auto& resource : m_resources)
+        resource->release();
+    }
+    
+    m_notified = false;
     m_resources.clear();
+    
+    // Resources may still store the old ID, so we
+    // need a new one in order to track them again
+    m_trackingId = allocTrackingId();
   }
   
 }
\ No newline at end of file
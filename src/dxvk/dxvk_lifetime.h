@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "dxvk_resource.h"
@@ -23,25 +24,59 @@ namespace dxvk {
     
     /**
      * \brief Adds a resource to track
+     * 
+     * Does nothing if the resource has already
+     * been added since the last reset.
      * \param [in] rc The resource to track
      */
-    void trackResource(Rc<DxvkResource>&& rc) {
+    void trackResource(DxvkResource* rc) {
+      if (!rc->markTracked(m_trackingId))
+        return;
+      
       rc->acquire();
-      m_resources.emplace_back(std::move(rc));
+      m_resources.emplace_back(rc);
+    }
+    
+    /**
+     * \brief Number of tracked resources
+     * \returns Tracked resource count
+     */
+    size_t count() const {
+      return m_resources.size();
     }
     
+    /**
+     * \brief Marks all resources as unused
+     * 
+     * Called once the command list has completed
+     * execution. Keeps the references to the tracked
+     * resources alive, so that destroying them can be
+     * deferred until the tracker gets reset.
+     */
+    void notify();
+    
     /**
      * \brief Resets the command list
      * 
      * Called automatically by the device when
      * the command list has completed execution.
+     * Marks resources as unused if that did not
+     * already happen, and releases all references.
      */
     void reset();
     
   private:
     
+    uint64_t                      m_trackingId;
+    bool                          m_notified = false;
     std::vector<Rc<DxvkResource>> m_resources;
     
+    static std::atomic<uint64_t>  s_trackingId;
+    
+    static uint64_t allocTrackingId() {
+      return ++s_trackingId;
+    }
+    
   };
   
 }
\ No newline at end of file
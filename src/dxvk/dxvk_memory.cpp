@@ -214,7 +214,9 @@ namespace dxvk {
       totalStats.memoryAllocated += m_memHeaps[i].stats.memoryAllocated;
       totalStats.memoryUsed      += m_memHeaps[i].stats.memoryUsed;
     }
-      
+    
+    totalStats.memorySpare = m_memorySpare.load();
+    
     return totalStats;
   }
   
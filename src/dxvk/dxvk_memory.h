@@ -12,10 +12,13 @@ namespace dxvk {
    * 
    * Reports the amount of device memory
    * allocated and used by the application.
+   * Spare memory is the part of the used
+   * memory held in unused buffer slices.
    */
   struct DxvkMemoryStats {
     VkDeviceSize memoryAllocated = 0;
     VkDeviceSize memoryUsed      = 0;
+    VkDeviceSize memorySpare     = 0;
   };
   
   
@@ -259,6 +262,27 @@ namespace dxvk {
      */
     DxvkMemoryStats getMemoryStats();
     
+    /**
+     * \brief Adds spare buffer memory
+     * 
+     * Called by buffers when slices become unused.
+     * \param [in] size Number of bytes to add
+     */
+    void addSpareMemory(VkDeviceSize size) {
+      m_memorySpare += size;
+    }
+    
+    /**
+     * \brief Removes spare buffer memory
+     * 
+     * Called by buffers when unused slices get
+     * reused or their memory gets released.
+     * \param [in] size Number of bytes to remove
+     */
+    void removeSpareMemory(VkDeviceSize size) {
+      m_memorySpare -= size;
+    }
+    
   private:
 
     const Rc<vk::DeviceFn>                 m_vkd;
@@ -268,6 +292,8 @@ namespace dxvk {
     
     std::mutex                                      m_mutex;
     std::array<DxvkMemoryHeap, VK_MAX_MEMORY_HEAPS> m_memHeaps;
+    
+    std::atomic<VkDeviceSize>                       m_memorySpare = { 0ull };
     std::array<DxvkMemoryType, VK_MAX_MEMORY_TYPES> m_memTypes;
     
     DxvkMemory tryAlloc(
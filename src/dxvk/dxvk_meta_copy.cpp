@@ -12,123 +12,6 @@
 
 namespace dxvk {
 
-  DxvkMetaCopyRenderPass::DxvkMetaCopyRenderPass(
-    const Rc<vk::DeviceFn>&   vkd,
-    const Rc<DxvkImageView>&  dstImageView,
-    const Rc<DxvkImageView>&  srcImageView,
-          bool                discardDst)
-  : m_vkd         (vkd),
-    m_dstImageView(dstImageView),
-    m_srcImageView(srcImageView),
-    m_renderPass  (createRenderPass(discardDst)),
-    m_framebuffer (createFramebuffer()) {
-
-  }
-  
-
-  DxvkMetaCopyRenderPass::~DxvkMetaCopyRenderPass() {
-    m_vkd->vkDestroyFramebuffer(m_vkd->device(), m_framebuffer, nullptr);
-    m_vkd->vkDestroyRenderPass (m_vkd->device(), m_renderPass,  nullptr);
-  }
-
-  
-  VkRenderPass DxvkMetaCopyRenderPass::createRenderPass(bool discard) const {
-    auto aspect = m_dstImageView->info().aspect;
-
-    std::array<VkSubpassDependency, 2> subpassDeps = {{
-      { VK_SUBPASS_EXTERNAL, 0,
-        m_dstImageView->imageInfo().stages,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
-      { 0, VK_SUBPASS_EXTERNAL,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        m_dstImageView->imageInfo().stages,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        m_dstImageView->imageInfo().access, 0 },
-    }};
-    
-    VkAttachmentDescription attachment;
-    attachment.flags            = 0;
-    attachment.format           = m_dstImageView->info().format;
-    attachment.samples          = m_dstImageView->imageInfo().sampleCount;
-    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_LOAD;
-    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
-    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment.initialLayout    = m_dstImageView->imageInfo().layout;
-    attachment.finalLayout      = m_dstImageView->imageInfo().layout;
-
-    if (discard) {
-      attachment.loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-    }
-    
-    VkAttachmentReference attachmentRef;
-    attachmentRef.attachment    = 0;
-    attachmentRef.layout        = (aspect & VK_IMAGE_ASPECT_COLOR_BIT)
-      ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-      : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    
-    VkSubpassDescription subpass;
-    subpass.flags                   = 0;
-    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.inputAttachmentCount    = 0;
-    subpass.pInputAttachments       = nullptr;
-    subpass.colorAttachmentCount    = 0;
-    subpass.pColorAttachments       = nullptr;
-    subpass.pResolveAttachments     = nullptr;
-    subpass.pDepthStencilAttachment = nullptr;
-    subpass.preserveAttachmentCount = 0;
-    subpass.pPreserveAttachments    = nullptr;
-
-    if (aspect & VK_IMAGE_ASPECT_COLOR_BIT) {
-      subpass.colorAttachmentCount  = 1;
-      subpass.pColorAttachments     = &attachmentRef;
-    } else {
-      subpass.pDepthStencilAttachment = &attachmentRef;
-    }
-
-    VkRenderPassCreateInfo info;
-    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    info.pNext                  = nullptr;
-    info.flags                  = 0;
-    info.attachmentCount        = 1;
-    info.pAttachments           = &attachment;
-    info.subpassCount           = 1;
-    info.pSubpasses             = &subpass;
-    info.dependencyCount        = subpassDeps.size();
-    info.pDependencies          = subpassDeps.data();
-
-    VkRenderPass result = VK_NULL_HANDLE;
-    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaCopyRenderPass: Failed to create render pass");
-    return result;
-  }
-
-
-  VkFramebuffer DxvkMetaCopyRenderPass::createFramebuffer() const {
-    VkImageView             dstViewHandle   = m_dstImageView->handle();
-    VkImageSubresourceRange dstSubresources = m_dstImageView->subresources();
-    VkExtent3D              dstExtent       = m_dstImageView->mipLevelExtent(0);
-
-    VkFramebufferCreateInfo fboInfo;
-    fboInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fboInfo.pNext           = nullptr;
-    fboInfo.flags           = 0;
-    fboInfo.renderPass      = m_renderPass;
-    fboInfo.attachmentCount = 1;
-    fboInfo.pAttachments    = &dstViewHandle;
-    fboInfo.width           = dstExtent.width;
-    fboInfo.height          = dstExtent.height;
-    fboInfo.layers          = dstSubresources.layerCount;
-    
-    VkFramebuffer result = VK_NULL_HANDLE;
-    if (m_vkd->vkCreateFramebuffer(m_vkd->device(), &fboInfo, nullptr, &result) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create target framebuffer");
-    return result;
-  }
-
-
   DxvkMetaCopyObjects::DxvkMetaCopyObjects(const Rc<vk::DeviceFn>& vkd)
   : m_vkd         (vkd),
     m_sampler     (createSampler()),
@@ -154,6 +37,9 @@ namespace dxvk {
       m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second.renderPass, nullptr);
     }
 
+    for (const auto& pair : m_renderPasses)
+      m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second, nullptr);
+
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_depth.fragMs, nullptr);
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_depth.frag2D, nullptr);
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_depth.frag1D, nullptr);
@@ -215,6 +101,20 @@ namespace dxvk {
     m_pipelines.insert({ key, pipeline });
     return pipeline;
   }
+
+
+  VkRenderPass DxvkMetaCopyObjects::getRenderPass(
+    const DxvkMetaCopyRenderPassKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto entry = m_renderPasses.find(key);
+    if (entry != m_renderPasses.end())
+      return entry->second;
+
+    VkRenderPass renderPass = createRenderPass(key);
+    m_renderPasses.insert({ key, renderPass });
+    return renderPass;
+  }
   
   
   VkSampler DxvkMetaCopyObjects::createSampler() const {
@@ -329,6 +229,76 @@ namespace dxvk {
     return result;
   }
 
+
+  VkRenderPass DxvkMetaCopyObjects::createRenderPass(
+    const DxvkMetaCopyRenderPassKey& key) const {
+    std::array<VkSubpassDependency, 2> subpassDeps = {{
+      { VK_SUBPASS_EXTERNAL, 0, key.stages,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
+      { 0, VK_SUBPASS_EXTERNAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, key.stages,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, key.access, 0 },
+    }};
+    
+    VkAttachmentDescription attachment;
+    attachment.flags            = 0;
+    attachment.format           = key.format;
+    attachment.samples          = key.samples;
+    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout    = key.layout;
+    attachment.finalLayout      = key.layout;
+
+    if (key.discard) {
+      attachment.loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+      attachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    
+    VkAttachmentReference attachmentRef;
+    attachmentRef.attachment    = 0;
+    attachmentRef.layout        = (key.aspect & VK_IMAGE_ASPECT_COLOR_BIT)
+      ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+      : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    
+    VkSubpassDescription subpass;
+    subpass.flags                   = 0;
+    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.inputAttachmentCount    = 0;
+    subpass.pInputAttachments       = nullptr;
+    subpass.colorAttachmentCount    = 0;
+    subpass.pColorAttachments       = nullptr;
+    subpass.pResolveAttachments     = nullptr;
+    subpass.pDepthStencilAttachment = nullptr;
+    subpass.preserveAttachmentCount = 0;
+    subpass.pPreserveAttachments    = nullptr;
+
+    if (key.aspect & VK_IMAGE_ASPECT_COLOR_BIT) {
+      subpass.colorAttachmentCount  = 1;
+      subpass.pColorAttachments     = &attachmentRef;
+    } else {
+      subpass.pDepthStencilAttachment = &attachmentRef;
+    }
+
+    VkRenderPassCreateInfo info;
+    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.pNext                  = nullptr;
+    info.flags                  = 0;
+    info.attachmentCount        = 1;
+    info.pAttachments           = &attachment;
+    info.subpassCount           = 1;
+    info.pSubpasses             = &subpass;
+    info.dependencyCount        = subpassDeps.size();
+    info.pDependencies          = subpassDeps.data();
+
+    VkRenderPass result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaCopyObjects: Failed to create render pass");
+    return result;
+  }
+
   
   VkDescriptorSetLayout DxvkMetaCopyObjects::createDescriptorSetLayout() const {
     VkDescriptorSetLayoutBinding binding;
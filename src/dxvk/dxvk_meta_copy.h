@@ -50,45 +50,42 @@ namespace dxvk {
   };
 
   /**
-   * \brief Copy framebuffer and render pass
+   * \brief Copy render pass key
    * 
-   * Creates a framebuffer and render
-   * pass object for an image view.
+   * Render passes depend on the properties of the
+   * destination image, and on whether its previous
+   * contents can be discarded.
    */
-  class DxvkMetaCopyRenderPass : public DxvkResource {
-
-  public:
-
-    DxvkMetaCopyRenderPass(
-      const Rc<vk::DeviceFn>&   vkd,
-      const Rc<DxvkImageView>&  dstImageView,
-      const Rc<DxvkImageView>&  srcImageView,
-            bool                discardDst);
-    
-    ~DxvkMetaCopyRenderPass();
-
-    VkRenderPass renderPass() const {
-      return m_renderPass;
+  struct DxvkMetaCopyRenderPassKey {
+    VkFormat              format;
+    VkSampleCountFlagBits samples;
+    VkImageAspectFlags    aspect;
+    VkImageLayout         layout;
+    VkPipelineStageFlags  stages;
+    VkAccessFlags         access;
+    VkBool32              discard;
+
+    bool eq(const DxvkMetaCopyRenderPassKey& other) const {
+      return this->format  == other.format
+          && this->samples == other.samples
+          && this->aspect  == other.aspect
+          && this->layout  == other.layout
+          && this->stages  == other.stages
+          && this->access  == other.access
+          && this->discard == other.discard;
     }
 
-    VkFramebuffer framebuffer() const {
-      return m_framebuffer;
+    size_t hash() const {
+      DxvkHashState result;
+      result.add(uint32_t(this->format));
+      result.add(uint32_t(this->samples));
+      result.add(uint32_t(this->aspect));
+      result.add(uint32_t(this->layout));
+      result.add(uint32_t(this->stages));
+      result.add(uint32_t(this->access));
+      result.add(uint32_t(this->discard));
+      return result;
     }
-
-  private:
-
-    const Rc<vk::DeviceFn>  m_vkd;
-
-    const Rc<DxvkImageView> m_dstImageView;
-    const Rc<DxvkImageView> m_srcImageView;
-    
-    VkRenderPass  m_renderPass  = VK_NULL_HANDLE;
-    VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
-
-    VkRenderPass createRenderPass(bool discard) const;
-
-    VkFramebuffer createFramebuffer() const;
-
   };
 
   /**
@@ -131,6 +128,17 @@ namespace dxvk {
             VkFormat              dstFormat,
             VkSampleCountFlagBits dstSamples);
 
+    /**
+     * \brief Retrieves render pass for a copy
+     * 
+     * Render passes are created on first use and
+     * live for as long as the meta copy objects.
+     * \param [in] key Render pass properties
+     * \returns Render pass for the copy target
+     */
+    VkRenderPass getRenderPass(
+      const DxvkMetaCopyRenderPassKey& key);
+
   private:
 
     struct FragShaders {
@@ -155,6 +163,11 @@ namespace dxvk {
       DxvkMetaCopyPipelineKey,
       DxvkMetaCopyPipeline,
       DxvkHash, DxvkEq> m_pipelines;
+
+    std::unordered_map<
+      DxvkMetaCopyRenderPassKey,
+      VkRenderPass,
+      DxvkHash, DxvkEq> m_renderPasses;
     
     VkSampler createSampler() const;
     
@@ -166,6 +179,9 @@ namespace dxvk {
 
     VkRenderPass createRenderPass(
       const DxvkMetaCopyPipelineKey&  key) const;
+
+    VkRenderPass createRenderPass(
+      const DxvkMetaCopyRenderPassKey& key) const;
     
     VkDescriptorSetLayout createDescriptorSetLayout() const;
     
@@ -1,5 +1,7 @@
+#include "dxvk_device.h"
 #include "dxvk_meta_mipgen.h"
 
+#include <dxvk_mipgen_comp.h>
 #include <dxvk_mipgen_vert.h>
 #include <dxvk_mipgen_geom.h>
 #include <dxvk_mipgen_frag_1d.h>
@@ -8,10 +10,53 @@
 
 namespace dxvk {
   
+  bool DxvkMetaMipGenCompute::isSupported(
+    const DxvkDevice*           device,
+    const DxvkImageCreateInfo&  imageInfo,
+          VkFormat              format,
+          VkExtent3D            extent,
+          uint32_t              levelCount) {
+    if (!device->features().core.features.shaderStorageImageWriteWithoutFormat)
+      return false;
+    
+    if (imageInfo.type        != VK_IMAGE_TYPE_2D
+     || imageInfo.sampleCount != VK_SAMPLE_COUNT_1_BIT
+     || imageInfo.tiling      != VK_IMAGE_TILING_OPTIMAL)
+      return false;
+    
+    if (levelCount - 1 > MaxLevels)
+      return false;
+    
+    // The compute shader uses a 2x2 box filter, which only matches
+    // the bilinear filter used by the render pass path if each mip
+    // level is exactly half the size of the previous one.
+    constexpr uint32_t maxSize = TileSize * MaxTiles;
+    
+    if (extent.width  > maxSize || (extent.width  & (extent.width  - 1))
+     || extent.height > maxSize || (extent.height & (extent.height - 1)))
+      return false;
+    
+    // Integer formats cannot be filtered, and storage
+    // image writes are not supported for sRGB formats
+    const DxvkFormatInfo* formatInfo = imageFormatInfo(format);
+    
+    if (formatInfo->aspectMask != VK_IMAGE_ASPECT_COLOR_BIT
+     || formatInfo->flags.any(
+          DxvkFormatFlag::BlockCompressed,
+          DxvkFormatFlag::SampledUInt,
+          DxvkFormatFlag::SampledSInt,
+          DxvkFormatFlag::ColorSpaceSrgb))
+      return false;
+    
+    VkFormatProperties formatProperties = device->adapter()->formatProperties(format);
+    return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+  }
+  
+  
   DxvkMetaMipGenRenderPass::DxvkMetaMipGenRenderPass(
-    const Rc<vk::DeviceFn>&   vkd,
+          VkRenderPass        renderPass,
     const Rc<DxvkImageView>&  view)
-  : m_vkd(vkd), m_view(view), m_renderPass(createRenderPass()) {
+  : m_view(view), m_renderPass(renderPass) {
     // Determine view type based on image type
     const std::array<std::pair<VkImageViewType, VkImageViewType>, 3> viewTypes = {{
       { VK_IMAGE_VIEW_TYPE_1D_ARRAY, VK_IMAGE_VIEW_TYPE_1D_ARRAY },
@@ -22,22 +67,11 @@ namespace dxvk {
     m_srcViewType = viewTypes.at(uint32_t(view->imageInfo().type)).first;
     m_dstViewType = viewTypes.at(uint32_t(view->imageInfo().type)).second;
     
-    // Create image views and framebuffers
+    // Look up image views and framebuffers
     m_passes.resize(view->info().numLevels - 1);
     
     for (uint32_t i = 0; i < m_passes.size(); i++)
-      m_passes.at(i) = this->createFramebuffer(i);
-  }
-  
-  
-  DxvkMetaMipGenRenderPass::~DxvkMetaMipGenRenderPass() {
-    for (const auto& pass : m_passes) {
-      m_vkd->vkDestroyFramebuffer(m_vkd->device(), pass.framebuffer, nullptr);
-      m_vkd->vkDestroyImageView(m_vkd->device(), pass.dstView, nullptr);
-      m_vkd->vkDestroyImageView(m_vkd->device(), pass.srcView, nullptr);
-    }
-    
-    m_vkd->vkDestroyRenderPass(m_vkd->device(), m_renderPass, nullptr);
+      m_passes.at(i) = this->getPass(i);
   }
   
   
@@ -51,135 +85,43 @@ namespace dxvk {
   }
   
   
-  VkRenderPass DxvkMetaMipGenRenderPass::createRenderPass() const {
-    std::array<VkSubpassDependency, 2> subpassDeps = {{
-      { VK_SUBPASS_EXTERNAL, 0,
-        m_view->imageInfo().stages,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
-      { 0, VK_SUBPASS_EXTERNAL,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        m_view->imageInfo().stages,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        m_view->imageInfo().access, 0 },
-    }};
-    
-    VkAttachmentDescription attachment;
-    attachment.flags            = 0;
-    attachment.format           = m_view->info().format;
-    attachment.samples          = VK_SAMPLE_COUNT_1_BIT;
-    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
-    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachment.finalLayout      = m_view->imageInfo().layout;
-    
-    VkAttachmentReference attachmentRef;
-    attachmentRef.attachment    = 0;
-    attachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    
-    VkSubpassDescription subpass;
-    subpass.flags               = 0;
-    subpass.pipelineBindPoint   = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.inputAttachmentCount = 0;
-    subpass.pInputAttachments   = nullptr;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments   = &attachmentRef;
-    subpass.pResolveAttachments = nullptr;
-    subpass.pDepthStencilAttachment = nullptr;
-    subpass.preserveAttachmentCount = 0;
-    subpass.pPreserveAttachments = nullptr;
+  DxvkMetaMipGenPass DxvkMetaMipGenRenderPass::getPass(uint32_t pass) const {
+    const Rc<DxvkImage>& image = m_view->image();
     
-    VkRenderPassCreateInfo info;
-    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    info.pNext                  = nullptr;
-    info.flags                  = 0;
-    info.attachmentCount        = 1;
-    info.pAttachments           = &attachment;
-    info.subpassCount           = 1;
-    info.pSubpasses             = &subpass;
-    info.dependencyCount        = subpassDeps.size();
-    info.pDependencies          = subpassDeps.data();
+    // Source image view, which points to the
+    // one mip level we're going to sample.
+    DxvkMetaViewKey srcKey;
+    srcKey.type   = m_srcViewType;
+    srcKey.format = m_view->info().format;
+    srcKey.usage  = VK_IMAGE_USAGE_SAMPLED_BIT;
+    srcKey.subresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    srcKey.subresources.baseMipLevel   = m_view->info().minLevel + pass;
+    srcKey.subresources.levelCount     = 1;
+    srcKey.subresources.baseArrayLayer = m_view->info().minLayer;
+    srcKey.subresources.layerCount     = m_view->info().numLayers;
     
-    VkRenderPass result = VK_NULL_HANDLE;
-    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create render pass");
-    return result;
-  }
-  
-  
-  DxvkMetaMipGenPass DxvkMetaMipGenRenderPass::createFramebuffer(uint32_t pass) const {
-    DxvkMetaMipGenPass result;
-    result.srcView      = VK_NULL_HANDLE;
-    result.dstView      = VK_NULL_HANDLE;
-    result.framebuffer  = VK_NULL_HANDLE;
-    
-    // Common image view info
-    VkImageViewCreateInfo viewInfo;
-    viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.pNext      = nullptr;
-    viewInfo.flags      = 0;
-    viewInfo.image      = m_view->imageHandle();
-    viewInfo.format     = m_view->info().format;
-    viewInfo.components = {
-      VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
-      VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
-    
-    // Create source image view, which points to
-    // the one mip level we're going to sample.
-    VkImageSubresourceRange srcSubresources;
-    srcSubresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    srcSubresources.baseMipLevel   = m_view->info().minLevel + pass;
-    srcSubresources.levelCount     = 1;
-    srcSubresources.baseArrayLayer = m_view->info().minLayer;
-    srcSubresources.layerCount     = m_view->info().numLayers;
-    
-    viewInfo.viewType         = m_srcViewType;
-    viewInfo.subresourceRange = srcSubresources;
-    
-    if (m_vkd->vkCreateImageView(m_vkd->device(), &viewInfo, nullptr, &result.srcView) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create source image view");
-    
-    // Create destination image view, which points
+    // Destination image view, which points
     // to the mip level we're going to render to.
-    VkExtent3D dstExtent = m_view->mipLevelExtent(pass + 1);
-    
-    VkImageSubresourceRange dstSubresources;
-    dstSubresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    dstSubresources.baseMipLevel   = m_view->info().minLevel + pass + 1;
-    dstSubresources.levelCount     = 1;
+    DxvkMetaViewKey dstKey;
+    dstKey.type   = m_dstViewType;
+    dstKey.format = m_view->info().format;
+    dstKey.usage  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    dstKey.subresources.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    dstKey.subresources.baseMipLevel   = m_view->info().minLevel + pass + 1;
+    dstKey.subresources.levelCount     = 1;
     
     if (m_view->imageInfo().type != VK_IMAGE_TYPE_3D) {
-      dstSubresources.baseArrayLayer = m_view->info().minLayer;
-      dstSubresources.layerCount     = m_view->info().numLayers;
+      dstKey.subresources.baseArrayLayer = m_view->info().minLayer;
+      dstKey.subresources.layerCount     = m_view->info().numLayers;
     } else {
-      dstSubresources.baseArrayLayer = 0;
-      dstSubresources.layerCount     = dstExtent.depth;
+      dstKey.subresources.baseArrayLayer = 0;
+      dstKey.subresources.layerCount     = m_view->mipLevelExtent(pass + 1).depth;
     }
     
-    viewInfo.viewType         = m_dstViewType;
-    viewInfo.subresourceRange = dstSubresources;
-    
-    if (m_vkd->vkCreateImageView(m_vkd->device(), &viewInfo, nullptr, &result.dstView) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create target image view");
-    
-    // Create framebuffer using the destination
-    // image view as its color attachment.
-    VkFramebufferCreateInfo fboInfo;
-    fboInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fboInfo.pNext           = nullptr;
-    fboInfo.flags           = 0;
-    fboInfo.renderPass      = m_renderPass;
-    fboInfo.attachmentCount = 1;
-    fboInfo.pAttachments    = &result.dstView;
-    fboInfo.width           = dstExtent.width;
-    fboInfo.height          = dstExtent.height;
-    fboInfo.layers          = dstSubresources.layerCount;
-    
-    if (m_vkd->vkCreateFramebuffer(m_vkd->device(), &fboInfo, nullptr, &result.framebuffer) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create target framebuffer");
-    
+    DxvkMetaMipGenPass result;
+    result.srcView      = image->getMetaView(srcKey);
+    result.dstView      = image->getMetaView(dstKey);
+    result.framebuffer  = image->getMetaFramebuffer(dstKey, m_renderPass);
     return result;
   }
   
@@ -191,15 +133,24 @@ namespace dxvk {
     m_shaderGeom  (createShaderModule(dxvk_mipgen_geom)),
     m_shaderFrag1D(createShaderModule(dxvk_mipgen_frag_1d)),
     m_shaderFrag2D(createShaderModule(dxvk_mipgen_frag_2d)),
-    m_shaderFrag3D(createShaderModule(dxvk_mipgen_frag_3d)) {
+    m_shaderFrag3D(createShaderModule(dxvk_mipgen_frag_3d)),
+    m_computePipeline(createComputePipeline()) {
     
   }
   
   
   DxvkMetaMipGenObjects::~DxvkMetaMipGenObjects() {
+    m_vkd->vkDestroyPipeline(m_vkd->device(), m_computePipeline.pipeHandle, nullptr);
+    m_vkd->vkDestroyDescriptorUpdateTemplateKHR(m_vkd->device(), m_computePipeline.dsetTemplate, nullptr);
+    m_vkd->vkDestroyPipelineLayout(m_vkd->device(), m_computePipeline.pipeLayout, nullptr);
+    m_vkd->vkDestroyDescriptorSetLayout(m_vkd->device(), m_computePipeline.dsetLayout, nullptr);
+    
     for (const auto& pair : m_renderPasses)
       m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second, nullptr);
     
+    for (const auto& pair : m_targetRenderPasses)
+      m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second, nullptr);
+    
     for (const auto& pair : m_pipelines) {
       m_vkd->vkDestroyPipeline(m_vkd->device(), pair.second.pipeHandle, nullptr);
       m_vkd->vkDestroyPipelineLayout(m_vkd->device(), pair.second.pipeLayout, nullptr);
@@ -235,6 +186,20 @@ namespace dxvk {
   }
   
   
+  VkRenderPass DxvkMetaMipGenObjects::getRenderPass(
+    const DxvkMetaMipGenRenderPassKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto entry = m_targetRenderPasses.find(key);
+    if (entry != m_targetRenderPasses.end())
+      return entry->second;
+    
+    VkRenderPass renderPass = this->createRenderPass(key);
+    m_targetRenderPasses.insert({ key, renderPass });
+    return renderPass;
+  }
+  
+  
   VkRenderPass DxvkMetaMipGenObjects::getRenderPass(VkFormat viewFormat) {
     auto entry = m_renderPasses.find(viewFormat);
     if (entry != m_renderPasses.end())
@@ -347,6 +312,65 @@ namespace dxvk {
   }
   
   
+  VkRenderPass DxvkMetaMipGenObjects::createRenderPass(
+    const DxvkMetaMipGenRenderPassKey& key) const {
+    std::array<VkSubpassDependency, 2> subpassDeps = {{
+      { VK_SUBPASS_EXTERNAL, 0,
+        key.stages,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
+      { 0, VK_SUBPASS_EXTERNAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        key.stages,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        key.access, 0 },
+    }};
+    
+    VkAttachmentDescription attachment;
+    attachment.flags            = 0;
+    attachment.format           = key.format;
+    attachment.samples          = VK_SAMPLE_COUNT_1_BIT;
+    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachment.finalLayout      = key.layout;
+    
+    VkAttachmentReference attachmentRef;
+    attachmentRef.attachment    = 0;
+    attachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    
+    VkSubpassDescription subpass;
+    subpass.flags               = 0;
+    subpass.pipelineBindPoint   = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.inputAttachmentCount = 0;
+    subpass.pInputAttachments   = nullptr;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments   = &attachmentRef;
+    subpass.pResolveAttachments = nullptr;
+    subpass.pDepthStencilAttachment = nullptr;
+    subpass.preserveAttachmentCount = 0;
+    subpass.pPreserveAttachments = nullptr;
+    
+    VkRenderPassCreateInfo info;
+    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.pNext                  = nullptr;
+    info.flags                  = 0;
+    info.attachmentCount        = 1;
+    info.pAttachments           = &attachment;
+    info.subpassCount           = 1;
+    info.pSubpasses             = &subpass;
+    info.dependencyCount        = subpassDeps.size();
+    info.pDependencies          = subpassDeps.data();
+    
+    VkRenderPass result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaMipGenObjects: Failed to create render pass");
+    return result;
+  }
+  
+  
   VkDescriptorSetLayout DxvkMetaMipGenObjects::createDescriptorSetLayout(
           VkImageViewType             viewType) const {
     VkDescriptorSetLayoutBinding binding;
@@ -548,4 +572,96 @@ namespace dxvk {
     return result;
   }
   
+  
+  DxvkMetaMipGenComputePipeline DxvkMetaMipGenObjects::createComputePipeline() const {
+    constexpr uint32_t levelCount = DxvkMetaMipGenCompute::MaxLevels;
+    
+    DxvkMetaMipGenComputePipeline pipe;
+    
+    std::array<VkDescriptorSetLayoutBinding, 4> bindings = {{
+      { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,          VK_SHADER_STAGE_COMPUTE_BIT, &m_sampler },
+      { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          levelCount, VK_SHADER_STAGE_COMPUTE_BIT, nullptr    },
+      { 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1,          VK_SHADER_STAGE_COMPUTE_BIT, nullptr    },
+      { 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1,          VK_SHADER_STAGE_COMPUTE_BIT, nullptr    },
+    }};
+    
+    VkDescriptorSetLayoutCreateInfo dsetInfo;
+    dsetInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    dsetInfo.pNext              = nullptr;
+    dsetInfo.flags              = 0;
+    dsetInfo.bindingCount       = bindings.size();
+    dsetInfo.pBindings          = bindings.data();
+    
+    if (m_vkd->vkCreateDescriptorSetLayout(m_vkd->device(), &dsetInfo, nullptr, &pipe.dsetLayout) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaMipGenObjects: Failed to create descriptor set layout");
+    
+    VkPushConstantRange pushRange;
+    pushRange.stageFlags        = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushRange.offset            = 0;
+    pushRange.size              = sizeof(DxvkMetaMipGenComputeArgs);
+    
+    VkPipelineLayoutCreateInfo layoutInfo;
+    layoutInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext            = nullptr;
+    layoutInfo.flags            = 0;
+    layoutInfo.setLayoutCount   = 1;
+    layoutInfo.pSetLayouts      = &pipe.dsetLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges    = &pushRange;
+    
+    if (m_vkd->vkCreatePipelineLayout(m_vkd->device(), &layoutInfo, nullptr, &pipe.pipeLayout) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaMipGenObjects: Failed to create pipeline layout");
+    
+    std::array<VkDescriptorUpdateTemplateEntryKHR, 4> entries = {{
+      { 0, 0, 1,          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, offsetof(DxvkMetaMipGenComputeDescriptors, srcImage),  0 },
+      { 1, 0, levelCount, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          offsetof(DxvkMetaMipGenComputeDescriptors, dstImages), sizeof(VkDescriptorImageInfo) },
+      { 2, 0, 1,          VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         offsetof(DxvkMetaMipGenComputeDescriptors, counters),  0 },
+      { 3, 0, 1,          VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         offsetof(DxvkMetaMipGenComputeDescriptors, texels),    0 },
+    }};
+    
+    VkDescriptorUpdateTemplateCreateInfoKHR templateInfo;
+    templateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    templateInfo.pNext = nullptr;
+    templateInfo.flags = 0;
+    templateInfo.descriptorUpdateEntryCount = entries.size();
+    templateInfo.pDescriptorUpdateEntries   = entries.data();
+    templateInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    templateInfo.descriptorSetLayout        = pipe.dsetLayout;
+    templateInfo.pipelineBindPoint          = VK_PIPELINE_BIND_POINT_COMPUTE;
+    templateInfo.pipelineLayout             = pipe.pipeLayout;
+    templateInfo.set                        = 0;
+    
+    if (m_vkd->vkCreateDescriptorUpdateTemplateKHR(m_vkd->device(), &templateInfo, nullptr, &pipe.dsetTemplate) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaMipGenObjects: Failed to create descriptor update template");
+    
+    VkShaderModule module = this->createShaderModule(dxvk_mipgen_comp);
+    
+    VkPipelineShaderStageCreateInfo stageInfo;
+    stageInfo.sType             = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.pNext             = nullptr;
+    stageInfo.flags             = 0;
+    stageInfo.stage             = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module            = module;
+    stageInfo.pName             = "main";
+    stageInfo.pSpecializationInfo = nullptr;
+    
+    VkComputePipelineCreateInfo info;
+    info.sType                  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    info.pNext                  = nullptr;
+    info.flags                  = 0;
+    info.stage                  = stageInfo;
+    info.layout                 = pipe.pipeLayout;
+    info.basePipelineHandle     = VK_NULL_HANDLE;
+    info.basePipelineIndex      = -1;
+    
+    VkResult status = m_vkd->vkCreateComputePipelines(
+      m_vkd->device(), VK_NULL_HANDLE, 1, &info, nullptr, &pipe.pipeHandle);
+    
+    m_vkd->vkDestroyShaderModule(m_vkd->device(), module, nullptr);
+    
+    if (status != VK_SUCCESS)
+      throw DxvkError("DxvkMetaMipGenObjects: Failed to create compute pipeline");
+    return pipe;
+  }
+  
 }
@@ -10,6 +10,8 @@
 
 namespace dxvk {
   
+  class DxvkDevice;
+  
   /**
    * \brief Push constant data
    */
@@ -17,6 +19,89 @@ namespace dxvk {
     uint32_t layerCount;
   };
   
+  /**
+   * \brief Compute mip map generation limits
+   * 
+   * Each workgroup of the compute shader reduces one tile
+   * of the source level, and the last workgroup reduces
+   * the resulting texels further. This limits the source
+   * image to 4096 pixels in each dimension. Array layers
+   * are processed in batches so that the scratch buffer
+   * has a fixed size.
+   */
+  struct DxvkMetaMipGenCompute {
+    /// Maximum number of levels generated by one dispatch
+    constexpr static uint32_t MaxLevels  = 12;
+    /// Size of the source tile processed by one workgroup
+    constexpr static uint32_t TileSize   = 64;
+    /// Maximum number of tiles per dimension and layer
+    constexpr static uint32_t MaxTiles   = 64;
+    /// Number of array layers processed by one dispatch
+    constexpr static uint32_t BatchLayers = 16;
+    /// Size of the per-layer counter region, in bytes
+    constexpr static VkDeviceSize CounterSize = BatchLayers * sizeof(uint32_t);
+    /// Size of the per-layer texel region, in bytes
+    constexpr static VkDeviceSize TexelSize = MaxTiles * MaxTiles * 4 * sizeof(float);
+    
+    /**
+     * \brief Checks whether the compute path can be used
+     * 
+     * Does not check whether the image was created with
+     * storage usage, since this is also used to decide
+     * whether to enable storage usage in the first place.
+     * \param [in] device The device
+     * \param [in] imageInfo Image properties
+     * \param [in] format Format of the view
+     * \param [in] extent Extent of the top level
+     * \param [in] levelCount Number of mip levels
+     * \returns \c true if mip maps can be generated
+     *    with the compute shader for this image
+     */
+    static bool isSupported(
+      const DxvkDevice*           device,
+      const DxvkImageCreateInfo&  imageInfo,
+            VkFormat              format,
+            VkExtent3D            extent,
+            uint32_t              levelCount);
+  };
+  
+  /**
+   * \brief Compute mip map generation arguments
+   * 
+   * Passed in as push constants
+   * to the compute shader.
+   */
+  struct DxvkMetaMipGenComputeArgs {
+    VkExtent2D srcExtent;
+    VkExtent2D tileCount;
+    uint32_t   levelCount;
+  };
+  
+  /**
+   * \brief Compute mip map generation descriptors
+   * 
+   * Unused destination level descriptors must still
+   * point to a valid image view. The counter buffer
+   * stores one counter per layer, and the texel buffer
+   * stores the intermediate texels of each layer.
+   */
+  struct DxvkMetaMipGenComputeDescriptors {
+    VkDescriptorImageInfo   srcImage;
+    VkDescriptorImageInfo   dstImages[DxvkMetaMipGenCompute::MaxLevels];
+    VkDescriptorBufferInfo  counters;
+    VkDescriptorBufferInfo  texels;
+  };
+  
+  /**
+   * \brief Compute mip map generation pipeline
+   */
+  struct DxvkMetaMipGenComputePipeline {
+    VkDescriptorUpdateTemplateKHR dsetTemplate;
+    VkDescriptorSetLayout         dsetLayout;
+    VkPipelineLayout              pipeLayout;
+    VkPipeline                    pipeHandle;
+  };
+  
   /**
    * \brief Mip map generation pipeline key
    * 
@@ -42,6 +127,36 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Mip map generation render pass key
+   * 
+   * Render passes used to render to a mip level
+   * depend on the properties of the image.
+   */
+  struct DxvkMetaMipGenRenderPassKey {
+    VkFormat             format;
+    VkImageLayout        layout;
+    VkPipelineStageFlags stages;
+    VkAccessFlags        access;
+    
+    bool eq(const DxvkMetaMipGenRenderPassKey& other) const {
+      return this->format == other.format
+          && this->layout == other.layout
+          && this->stages == other.stages
+          && this->access == other.access;
+    }
+    
+    size_t hash() const {
+      DxvkHashState result;
+      result.add(uint32_t(this->format));
+      result.add(uint32_t(this->layout));
+      result.add(uint32_t(this->stages));
+      result.add(uint32_t(this->access));
+      return result;
+    }
+  };
+  
+  
   /**
    * \brief Mip map generation pipeline
    * 
@@ -71,20 +186,19 @@ namespace dxvk {
   /**
    * \brief Mip map generation render pass
    * 
-   * Stores image views, framebuffer objects and
-   * a render pass object for mip map generation.
-   * This must be created per image view.
+   * Looks up the image views and framebuffers needed
+   * to generate mip maps for an image view. All these
+   * objects are owned by the image, so this object can
+   * be discarded once commands have been recorded.
    */
-  class DxvkMetaMipGenRenderPass : public DxvkResource {
+  class DxvkMetaMipGenRenderPass {
     
   public:
     
     DxvkMetaMipGenRenderPass(
-      const Rc<vk::DeviceFn>&   vkd,
+            VkRenderPass        renderPass,
       const Rc<DxvkImageView>&  view);
     
-    ~DxvkMetaMipGenRenderPass();
-    
     /**
      * \brief Render pass handle
      * \returns Render pass handle
@@ -136,7 +250,6 @@ namespace dxvk {
     
   private:
     
-    Rc<vk::DeviceFn>  m_vkd;
     Rc<DxvkImageView> m_view;
     
     VkRenderPass m_renderPass;
@@ -146,9 +259,7 @@ namespace dxvk {
     
     std::vector<DxvkMetaMipGenPass> m_passes;
     
-    VkRenderPass createRenderPass() const;
-    
-    DxvkMetaMipGenPass createFramebuffer(uint32_t pass) const;
+    DxvkMetaMipGenPass getPass(uint32_t pass) const;
     
   };
   
@@ -179,6 +290,28 @@ namespace dxvk {
             VkImageViewType viewType,
             VkFormat        viewFormat);
     
+    /**
+     * \brief Retrieves the compute pipeline
+     * 
+     * The compute pipeline works for any 2D image
+     * format that supports storage image writes.
+     * \returns The compute mip map generation pipeline
+     */
+    DxvkMetaMipGenComputePipeline getComputePipeline() const {
+      return m_computePipeline;
+    }
+    
+    /**
+     * \brief Retrieves render pass for a mip level
+     * 
+     * Render passes are created on first use and live
+     * for as long as the mip map generation objects.
+     * \param [in] key Render pass properties
+     * \returns Render pass for the destination level
+     */
+    VkRenderPass getRenderPass(
+      const DxvkMetaMipGenRenderPassKey& key);
+    
   private:
     
     Rc<vk::DeviceFn>  m_vkd;
@@ -191,12 +324,19 @@ namespace dxvk {
     VkShaderModule m_shaderFrag2D;
     VkShaderModule m_shaderFrag3D;
     
+    DxvkMetaMipGenComputePipeline m_computePipeline;
+    
     std::mutex m_mutex;
     
     std::unordered_map<
       VkFormat,
       VkRenderPass> m_renderPasses;
     
+    std::unordered_map<
+      DxvkMetaMipGenRenderPassKey,
+      VkRenderPass,
+      DxvkHash, DxvkEq> m_targetRenderPasses;
+    
     std::unordered_map<
       DxvkMetaMipGenPipelineKey,
       DxvkMetaMipGenPipeline,
@@ -216,6 +356,9 @@ namespace dxvk {
     VkRenderPass createRenderPass(
             VkFormat                    format) const;
     
+    VkRenderPass createRenderPass(
+      const DxvkMetaMipGenRenderPassKey& key) const;
+    
     VkDescriptorSetLayout createDescriptorSetLayout(
             VkImageViewType             viewType) const;
     
@@ -227,6 +370,8 @@ namespace dxvk {
             VkPipelineLayout            pipelineLayout,
             VkRenderPass                renderPass) const;
     
+    DxvkMetaMipGenComputePipeline createComputePipeline() const;
+    
   };
   
 }
@@ -8,104 +8,6 @@
 
 namespace dxvk {
   
-  DxvkMetaResolveRenderPass::DxvkMetaResolveRenderPass(
-    const Rc<vk::DeviceFn>&   vkd,
-    const Rc<DxvkImageView>&  dstImageView,
-    const Rc<DxvkImageView>&  srcImageView)
-  : m_vkd(vkd),
-    m_dstImageView(dstImageView),
-    m_srcImageView(srcImageView),
-    m_renderPass  (createRenderPass ()),
-    m_framebuffer (createFramebuffer()) { }
-  
-
-  DxvkMetaResolveRenderPass::~DxvkMetaResolveRenderPass() {
-    m_vkd->vkDestroyFramebuffer(m_vkd->device(), m_framebuffer, nullptr);
-    m_vkd->vkDestroyRenderPass (m_vkd->device(), m_renderPass,  nullptr);
-  }
-
-
-  VkRenderPass DxvkMetaResolveRenderPass::createRenderPass() const {
-    std::array<VkSubpassDependency, 2> subpassDeps = {{
-      { VK_SUBPASS_EXTERNAL, 0,
-        m_dstImageView->imageInfo().stages,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
-      { 0, VK_SUBPASS_EXTERNAL,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        m_dstImageView->imageInfo().stages,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        m_dstImageView->imageInfo().access, 0 },
-    }};
-    
-    VkAttachmentDescription attachment;
-    attachment.flags            = 0;
-    attachment.format           = m_dstImageView->info().format;
-    attachment.samples          = VK_SAMPLE_COUNT_1_BIT;
-    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
-    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachment.finalLayout      = m_dstImageView->imageInfo().layout;
-    
-    VkAttachmentReference attachmentRef;
-    attachmentRef.attachment    = 0;
-    attachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    
-    VkSubpassDescription subpass;
-    subpass.flags               = 0;
-    subpass.pipelineBindPoint   = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.inputAttachmentCount = 0;
-    subpass.pInputAttachments   = nullptr;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments   = &attachmentRef;
-    subpass.pResolveAttachments = nullptr;
-    subpass.pDepthStencilAttachment = nullptr;
-    subpass.preserveAttachmentCount = 0;
-    subpass.pPreserveAttachments = nullptr;
-
-    VkRenderPassCreateInfo info;
-    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    info.pNext                  = nullptr;
-    info.flags                  = 0;
-    info.attachmentCount        = 1;
-    info.pAttachments           = &attachment;
-    info.subpassCount           = 1;
-    info.pSubpasses             = &subpass;
-    info.dependencyCount        = subpassDeps.size();
-    info.pDependencies          = subpassDeps.data();
-
-    VkRenderPass result = VK_NULL_HANDLE;
-    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaResolveRenderPass: Failed to create render pass");
-    return result;
-  }
-
-
-  VkFramebuffer DxvkMetaResolveRenderPass::createFramebuffer() const {
-    VkImageView             dstViewHandle   = m_dstImageView->handle();
-    VkImageSubresourceRange dstSubresources = m_dstImageView->subresources();
-    VkExtent3D              dstExtent       = m_dstImageView->mipLevelExtent(0);
-
-    VkFramebufferCreateInfo fboInfo;
-    fboInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fboInfo.pNext           = nullptr;
-    fboInfo.flags           = 0;
-    fboInfo.renderPass      = m_renderPass;
-    fboInfo.attachmentCount = 1;
-    fboInfo.pAttachments    = &dstViewHandle;
-    fboInfo.width           = dstExtent.width;
-    fboInfo.height          = dstExtent.height;
-    fboInfo.layers          = dstSubresources.layerCount;
-    
-    VkFramebuffer result = VK_NULL_HANDLE;
-    if (m_vkd->vkCreateFramebuffer(m_vkd->device(), &fboInfo, nullptr, &result) != VK_SUCCESS)
-      throw DxvkError("DxvkMetaMipGenRenderPass: Failed to create target framebuffer");
-    return result;
-  }
-
-  
   DxvkMetaResolveObjects::DxvkMetaResolveObjects(const Rc<vk::DeviceFn>& vkd)
   : m_vkd         (vkd),
     m_sampler     (createSampler()),
@@ -126,6 +28,9 @@ namespace dxvk {
       m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second.renderPass, nullptr);
     }
 
+    for (const auto& pair : m_renderPasses)
+      m_vkd->vkDestroyRenderPass(m_vkd->device(), pair.second, nullptr);
+
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_shaderFragI, nullptr);
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_shaderFragU, nullptr);
     m_vkd->vkDestroyShaderModule(m_vkd->device(), m_shaderFragF, nullptr);
@@ -149,6 +54,20 @@ namespace dxvk {
   }
 
 
+  VkRenderPass DxvkMetaResolveObjects::getRenderPass(
+    const DxvkMetaResolveRenderPassKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto entry = m_renderPasses.find(key);
+    if (entry != m_renderPasses.end())
+      return entry->second;
+
+    VkRenderPass renderPass = this->createRenderPass(key);
+    m_renderPasses.insert({ key, renderPass });
+    return renderPass;
+  }
+
+
   VkSampler DxvkMetaResolveObjects::createSampler() const {
     VkSamplerCreateInfo info;
     info.sType                  = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -247,6 +166,62 @@ namespace dxvk {
     return result;
   }
 
+
+  VkRenderPass DxvkMetaResolveObjects::createRenderPass(
+    const DxvkMetaResolveRenderPassKey& key) const {
+    std::array<VkSubpassDependency, 2> subpassDeps = {{
+      { VK_SUBPASS_EXTERNAL, 0, key.stages,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 0 },
+      { 0, VK_SUBPASS_EXTERNAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, key.stages,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, key.access, 0 },
+    }};
+    
+    VkAttachmentDescription attachment;
+    attachment.flags            = 0;
+    attachment.format           = key.format;
+    attachment.samples          = VK_SAMPLE_COUNT_1_BIT;
+    attachment.loadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachment.finalLayout      = key.layout;
+    
+    VkAttachmentReference attachmentRef;
+    attachmentRef.attachment    = 0;
+    attachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    
+    VkSubpassDescription subpass;
+    subpass.flags               = 0;
+    subpass.pipelineBindPoint   = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.inputAttachmentCount = 0;
+    subpass.pInputAttachments   = nullptr;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments   = &attachmentRef;
+    subpass.pResolveAttachments = nullptr;
+    subpass.pDepthStencilAttachment = nullptr;
+    subpass.preserveAttachmentCount = 0;
+    subpass.pPreserveAttachments = nullptr;
+
+    VkRenderPassCreateInfo info;
+    info.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.pNext                  = nullptr;
+    info.flags                  = 0;
+    info.attachmentCount        = 1;
+    info.pAttachments           = &attachment;
+    info.subpassCount           = 1;
+    info.pSubpasses             = &subpass;
+    info.dependencyCount        = subpassDeps.size();
+    info.pDependencies          = subpassDeps.data();
+
+    VkRenderPass result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateRenderPass(m_vkd->device(), &info, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("DxvkMetaResolveObjects: Failed to create render pass");
+    return result;
+  }
+
   
   VkDescriptorSetLayout DxvkMetaResolveObjects::createDescriptorSetLayout() const {
     VkDescriptorSetLayoutBinding binding;
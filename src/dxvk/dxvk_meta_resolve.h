@@ -7,6 +7,7 @@
 
 #include "dxvk_barrier.h"
 #include "dxvk_cmdlist.h"
+#include "dxvk_hash.h"
 #include "dxvk_resource.h"
 
 namespace dxvk {
@@ -25,44 +26,33 @@ namespace dxvk {
   };
 
   /**
-   * \brief Meta resolve render pass
+   * \brief Resolve render pass key
    * 
-   * Stores a framebuffer and image view objects
-   * for a meta resolve operation. Can be tracked.
+   * The previous contents of the destination image
+   * are always discarded, so render passes only
+   * depend on the destination image properties.
    */
-  class DxvkMetaResolveRenderPass : public DxvkResource {
-    
-  public:
-    
-    DxvkMetaResolveRenderPass(
-      const Rc<vk::DeviceFn>&   vkd,
-      const Rc<DxvkImageView>&  dstImageView,
-      const Rc<DxvkImageView>&  srcImageView);
-    
-    ~DxvkMetaResolveRenderPass();
-    
-    VkRenderPass renderPass() const {
-      return m_renderPass;
+  struct DxvkMetaResolveRenderPassKey {
+    VkFormat              format;
+    VkImageLayout         layout;
+    VkPipelineStageFlags  stages;
+    VkAccessFlags         access;
+
+    bool eq(const DxvkMetaResolveRenderPassKey& other) const {
+      return this->format == other.format
+          && this->layout == other.layout
+          && this->stages == other.stages
+          && this->access == other.access;
     }
 
-    VkFramebuffer framebuffer() const {
-      return m_framebuffer;
+    size_t hash() const {
+      DxvkHashState result;
+      result.add(uint32_t(this->format));
+      result.add(uint32_t(this->layout));
+      result.add(uint32_t(this->stages));
+      result.add(uint32_t(this->access));
+      return result;
     }
-
-  private:
-    
-    const Rc<vk::DeviceFn>  m_vkd;
-
-    const Rc<DxvkImageView> m_dstImageView;
-    const Rc<DxvkImageView> m_srcImageView;
-    
-    VkRenderPass  m_renderPass  = VK_NULL_HANDLE;
-    VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
-
-    VkRenderPass createRenderPass() const;
-
-    VkFramebuffer createFramebuffer() const;
-
   };
 
 
@@ -90,6 +80,17 @@ namespace dxvk {
     DxvkMetaResolvePipeline getPipeline(
             VkFormat            format);
 
+    /**
+     * \brief Retrieves render pass for a resolve
+     * 
+     * Render passes are created on first use and live
+     * for as long as the meta resolve objects.
+     * \param [in] key Render pass properties
+     * \returns Render pass for the resolve target
+     */
+    VkRenderPass getRenderPass(
+      const DxvkMetaResolveRenderPassKey& key);
+
   private:
 
     Rc<vk::DeviceFn> m_vkd;
@@ -106,6 +107,11 @@ namespace dxvk {
     
     std::unordered_map<VkFormat, DxvkMetaResolvePipeline> m_pipelines;
 
+    std::unordered_map<
+      DxvkMetaResolveRenderPassKey,
+      VkRenderPass,
+      DxvkHash, DxvkEq> m_renderPasses;
+
     VkSampler createSampler() const;
     
     VkShaderModule createShaderModule(
@@ -116,6 +122,9 @@ namespace dxvk {
 
     VkRenderPass createRenderPass(
             VkFormat              format) const;
+
+    VkRenderPass createRenderPass(
+      const DxvkMetaResolveRenderPassKey& key) const;
     
     VkDescriptorSetLayout createDescriptorSetLayout() const;
     
@@ -13,7 +13,7 @@ namespace dxvk {
           uint32_t              slot,
           VkDescriptorType      type,
           VkImageViewType       view,
-          VkShaderStageFlagBits stage,
+          VkShaderStageFlags    stage,
           VkAccessFlags         access) {
     uint32_t bindingId = this->getBindingId(slot);
     
@@ -32,6 +32,20 @@ namespace dxvk {
   }
   
   
+  void DxvkDescriptorSlotMapping::merge(
+    const DxvkDescriptorSlotMapping& mapping) {
+    // Fast path for the first shader of a pipeline, in
+    // which case we can just copy the entire mapping
+    if (m_descriptorSlots.empty()) {
+      m_descriptorSlots = mapping.m_descriptorSlots;
+      return;
+    }
+
+    for (const auto& slot : mapping.m_descriptorSlots)
+      this->defineSlot(slot.slot, slot.type, slot.view, slot.stages, slot.access);
+  }
+  
+  
   uint32_t DxvkDescriptorSlotMapping::getBindingId(uint32_t slot) const {
     // This won't win a performance competition, but the number
     // of bindings used by a shader is usually much smaller than
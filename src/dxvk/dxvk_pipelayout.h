@@ -83,9 +83,21 @@ namespace dxvk {
             uint32_t              slot,
             VkDescriptorType      type,
             VkImageViewType       view,
-            VkShaderStageFlagBits stage,
+            VkShaderStageFlags    stage,
             VkAccessFlags         access);
     
+    /**
+     * \brief Merges another slot mapping
+     * 
+     * Defines all slots of the given mapping in this
+     * mapping, in order. This is used to combine the
+     * per-shader mappings that are computed at shader
+     * creation time into a pipeline slot mapping.
+     * \param [in] mapping Slot mapping to merge
+     */
+    void merge(
+      const DxvkDescriptorSlotMapping& mapping);
+    
     /**
      * \brief Gets binding ID for a slot
      * 
@@ -52,7 +52,19 @@ namespace dxvk {
   
   
   DxvkPipelineManager::~DxvkPipelineManager() {
+    static const std::array<const char*, 3> s_partNames = {
+      "vertex input", "fragment output", "full" };
     
+    for (uint32_t i = 0; i < m_compileCounters.size(); i++) {
+      auto stats = this->getCompileStats(DxvkGraphicsPipelineStatePart(i));
+      
+      if (stats.numPipelines) {
+        Logger::debug(str::format("DxvkPipelineManager: Compiled ",
+          stats.numPipelines, " ", s_partNames[i], " variants in ",
+          stats.compileTimeUs / 1000, " ms (avg. ",
+          stats.compileTimeUs / stats.numPipelines, " us)"));
+      }
+    }
   }
   
   
@@ -113,6 +125,13 @@ namespace dxvk {
     if (m_stateCache != nullptr)
       m_stateCache->registerShader(shader);
   }
+  
+  
+  void DxvkPipelineManager::setSpecConstant(
+          DxvkSpecConstantId            specId,
+          uint32_t                      value) {
+    m_specConstants.set(specId, value);
+  }
 
 
   DxvkPipelineCount DxvkPipelineManager::getPipelineCount() const {
@@ -122,4 +141,24 @@ namespace dxvk {
     return result;
   }
   
+  
+  DxvkPipelineCompileStats DxvkPipelineManager::getCompileStats(
+          DxvkGraphicsPipelineStatePart part) const {
+    const auto& counters = m_compileCounters[uint32_t(part)];
+    
+    DxvkPipelineCompileStats result;
+    result.numPipelines  = counters.numPipelines.load();
+    result.compileTimeUs = counters.compileTimeUs.load();
+    return result;
+  }
+  
+  
+  void DxvkPipelineManager::addCompileTime(
+          DxvkGraphicsPipelineStatePart part,
+          uint64_t                      timeUs) {
+    auto& counters = m_compileCounters[uint32_t(part)];
+    counters.numPipelines  += 1;
+    counters.compileTimeUs += timeUs;
+  }
+  
 }
@@ -5,6 +5,7 @@
 
 #include "dxvk_compute.h"
 #include "dxvk_graphics.h"
+#include "dxvk_spec_const.h"
 
 namespace dxvk {
 
@@ -21,6 +22,18 @@ namespace dxvk {
     uint32_t numComputePipelines;
   };
   
+  /**
+   * \brief Pipeline compile statistics
+   * 
+   * Stores the number of graphics pipelines compiled
+   * for a given kind of state variant, as well as the
+   * total time spent compiling them, in microseconds.
+   */
+  struct DxvkPipelineCompileStats {
+    uint32_t numPipelines;
+    uint64_t compileTimeUs;
+  };
+  
   /**
    * \brief Compute pipeline key
    * 
@@ -122,13 +135,41 @@ namespace dxvk {
     void registerShader(
       const Rc<DxvkShader>&         shader);
     
+    /**
+     * \brief Sets device spec constant value
+     * 
+     * Must be called before any pipelines that use
+     * the given spec constant are being compiled.
+     * \param [in] specId Spec constant ID
+     * \param [in] value Spec constant value
+     */
+    void setSpecConstant(
+            DxvkSpecConstantId            specId,
+            uint32_t                      value);
+    
     /**
      * \brief Retrieves total pipeline count
      * \returns Number of compute/graphics pipelines
      */
     DxvkPipelineCount getPipelineCount() const;
+    
+    /**
+     * \brief Retrieves graphics pipeline compile statistics
+     * 
+     * \param [in] part State part by which the compiled
+     *    pipelines differed from their base pipeline
+     * \returns Pipeline count and total compile time
+     */
+    DxvkPipelineCompileStats getCompileStats(
+            DxvkGraphicsPipelineStatePart part) const;
+    
   private:
     
+    struct CompileCounters {
+      std::atomic<uint32_t> numPipelines  = { 0u };
+      std::atomic<uint64_t> compileTimeUs = { 0ull };
+    };
+    
     const DxvkDevice*         m_device;
     Rc<DxvkPipelineCache>     m_cache;
     Rc<DxvkStateCache>        m_stateCache;
@@ -136,6 +177,10 @@ namespace dxvk {
     std::atomic<uint32_t>     m_numComputePipelines  = { 0 };
     std::atomic<uint32_t>     m_numGraphicsPipelines = { 0 };
     
+    std::array<CompileCounters, 3> m_compileCounters;
+    
+    DxvkSpecConstantValues    m_specConstants;
+    
     std::mutex m_mutex;
     
     std::unordered_map<
@@ -150,6 +195,10 @@ namespace dxvk {
       DxvkPipelineKeyHash,
       DxvkPipelineKeyEq> m_graphicsPipelines;
     
+    void addCompileTime(
+            DxvkGraphicsPipelineStatePart part,
+            uint64_t                      timeUs);
+    
   };
   
 }
\ No newline at end of file
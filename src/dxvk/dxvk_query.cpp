@@ -51,6 +51,19 @@ namespace dxvk {
   }
   
   
+  uint32_t DxvkQuery::getVulkanQuery(
+          uint32_t        revision,
+          DxvkQueryHandle& handle) {
+    std::unique_lock<sync::TicketLock> lock(m_mutex);
+    
+    if (m_revision != revision)
+      return ~0u;
+    
+    handle = m_lastHandle;
+    return m_queryCount;
+  }
+  
+  
   void DxvkQuery::beginRecording(uint32_t revision) {
     std::unique_lock<sync::TicketLock> lock(m_mutex);
     
@@ -74,8 +87,10 @@ namespace dxvk {
   void DxvkQuery::associateQuery(uint32_t revision, DxvkQueryHandle handle) {
     std::unique_lock<sync::TicketLock> lock(m_mutex);
     
-    if (m_revision == revision)
+    if (m_revision == revision) {
       m_queryCount += 1;
+      m_lastHandle  = handle;
+    }
     
     // Assign the handle either way as this
     // will be used by the DXVK context.
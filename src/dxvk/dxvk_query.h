@@ -178,6 +178,22 @@ namespace dxvk {
      */
     DxvkQueryHandle getHandle();
     
+    /**
+     * \brief Retrieves Vulkan query of a revision
+     * 
+     * Returns the last Vulkan query that was used to
+     * record the given revision, so that its results
+     * can be copied on the GPU. This is only useful if
+     * exactly one Vulkan query was used.
+     * \param [in] revision Query version ID
+     * \param [out] handle The last query handle
+     * \returns Number of Vulkan queries used for the
+     *    revision, or \c ~0u if it is out of date
+     */
+    uint32_t getVulkanQuery(
+            uint32_t        revision,
+            DxvkQueryHandle& handle);
+    
     /**
      * \brief Begins recording the query
      * 
@@ -229,6 +245,7 @@ namespace dxvk {
     DxvkQueryStatus m_status   = DxvkQueryStatus::Created;
     DxvkQueryData   m_data     = {};
     DxvkQueryHandle m_handle;
+    DxvkQueryHandle m_lastHandle;
     
     uint32_t m_queryIndex = 0;
     uint32_t m_queryCount = 0;
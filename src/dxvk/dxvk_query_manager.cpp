@@ -3,8 +3,8 @@
 
 namespace dxvk {
 
-  DxvkQueryManager::DxvkQueryManager(const Rc<vk::DeviceFn>& vkd)
-  : m_vkd(vkd) {
+  DxvkQueryManager::DxvkQueryManager(DxvkDevice* device)
+  : m_device(device) {
     
   }
 
@@ -29,7 +29,7 @@ namespace dxvk {
       if (queryPool != nullptr)
         this->trackQueryPool(cmd, queryPool);
       
-      queryPool = new DxvkQueryPool(m_vkd, queryType, MaxNumQueryCountPerPool);
+      queryPool = new DxvkQueryPool(m_device, queryType, MaxNumQueryCountPerPool);
       queryPool->reset(cmd);
 
       queryHandle = queryPool->allocQuery(query);
@@ -100,17 +100,61 @@ namespace dxvk {
     this->trackQueryPool(cmd, m_pipeStats);
     this->trackQueryPool(cmd, m_timestamp);
     this->trackQueryPool(cmd, m_xfbStream);
+    
+    if (m_pendingRanges.size() == 0)
+      return;
+    
+    // Resolve query results on the GPU so that the submission
+    // thread only needs to read back host memory once the
+    // command list has completed execution.
+    for (const DxvkQueryRange& range : m_pendingRanges)
+      range.queryPool->recordResolve(cmd, range.queryIndex, range.queryCount);
+    
+    VkMemoryBarrier barrier;
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext         = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    
+    cmd->cmdPipelineBarrier(
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_PIPELINE_STAGE_HOST_BIT, 0,
+      1, &barrier, 0, nullptr, 0, nullptr);
+    
+    m_pendingRanges.clear();
   }
 
 
+  bool DxvkQueryManager::isQueryPoolAlive(
+          VkQueryPool           queryPool) const {
+    std::array<const DxvkQueryPool*, 4> pools = {{
+      m_occlusion.ptr(), m_pipeStats.ptr(),
+      m_timestamp.ptr(), m_xfbStream.ptr() }};
+    
+    for (const DxvkQueryPool* pool : pools) {
+      if (pool != nullptr && pool->handle() == queryPool)
+        return true;
+    }
+    
+    for (const DxvkQueryRange& range : m_pendingRanges) {
+      if (range.queryPool->handle() == queryPool)
+        return true;
+    }
+    
+    return false;
+  }
+  
+  
   void DxvkQueryManager::trackQueryPool(
     const Rc<DxvkCommandList>&  cmd,
     const Rc<DxvkQueryPool>&    pool) {
     if (pool != nullptr) {
       DxvkQueryRange range = pool->getActiveQueryRange();
 
-      if (range.queryCount > 0)
+      if (range.queryCount > 0) {
+        m_pendingRanges.push_back(range);
         cmd->trackQueryRange(std::move(range));
+      }
     }
   }
 
@@ -18,7 +18,7 @@ namespace dxvk {
 
   public:
 
-    DxvkQueryManager(const Rc<vk::DeviceFn>& vkd);
+    DxvkQueryManager(DxvkDevice* device);
     ~DxvkQueryManager();
 
     /**
@@ -86,15 +86,32 @@ namespace dxvk {
      * \brief Tracks query pools
      *
      * Adds all current non-empty query pools to
-     * the query tracker of the given command list.
+     * the query tracker of the given command list,
+     * and records commands to copy the results of
+     * all queries tracked since the last call to the
+     * readback buffers of the respective query pools.
+     * Must not be called inside a render pass.
      * \param [in] cmd The context's command list
      */
     void trackQueryPools(
       const Rc<DxvkCommandList>&  cmd);
+    
+    /**
+     * \brief Checks whether a query pool is alive
+     * 
+     * A query pool is guaranteed to be alive until the
+     * end of the current command list if it is either
+     * the current pool of its type, or if it has been
+     * retired during the current command list.
+     * \param [in] queryPool Vulkan query pool handle
+     * \returns \c true if the pool can be used
+     */
+    bool isQueryPoolAlive(
+            VkQueryPool           queryPool) const;
 
   private:
 
-    const Rc<vk::DeviceFn> m_vkd;
+    DxvkDevice*            m_device;
 
     uint32_t m_activeTypes = 0;
 
@@ -104,6 +121,7 @@ namespace dxvk {
     Rc<DxvkQueryPool> m_xfbStream;
 
     std::vector<DxvkQueryRevision> m_activeQueries;
+    std::vector<DxvkQueryRange>    m_pendingRanges;
 
     void trackQueryPool(
       const Rc<DxvkCommandList>&  cmd,
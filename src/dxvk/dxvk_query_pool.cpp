@@ -1,13 +1,14 @@
 #include "dxvk_cmdlist.h"
+#include "dxvk_device.h"
 #include "dxvk_query_pool.h"
 
 namespace dxvk {
   
   DxvkQueryPool::DxvkQueryPool(
-    const Rc<vk::DeviceFn>& vkd,
+          DxvkDevice*       device,
           VkQueryType       queryType,
           uint32_t          queryCount)
-  : m_vkd(vkd), m_queryCount(queryCount), m_queryType(queryType) {
+  : m_vkd(device->vkd()), m_queryCount(queryCount), m_queryType(queryType) {
     m_queries.resize(queryCount);
     
     VkQueryPoolCreateInfo info;
@@ -35,6 +36,18 @@ namespace dxvk {
     
     if (m_vkd->vkCreateQueryPool(m_vkd->device(), &info, nullptr, &m_queryPool) != VK_SUCCESS)
       Logger::err("DxvkQueryPool: Failed to create query pool");
+    
+    DxvkBufferCreateInfo bufferInfo;
+    bufferInfo.size   = sizeof(DxvkQueryData) * queryCount;
+    bufferInfo.usage  = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.stages = VK_PIPELINE_STAGE_TRANSFER_BIT
+                      | VK_PIPELINE_STAGE_HOST_BIT;
+    bufferInfo.access = VK_ACCESS_TRANSFER_WRITE_BIT
+                      | VK_ACCESS_HOST_READ_BIT;
+    
+    m_readback = device->createBuffer(bufferInfo,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
   }
   
   
@@ -64,36 +77,27 @@ namespace dxvk {
   }
   
   
-  VkResult DxvkQueryPool::getData(
+  void DxvkQueryPool::recordResolve(
+    const Rc<DxvkCommandList>& cmd,
           uint32_t          queryIndex,
           uint32_t          queryCount) {
-    std::array<DxvkQueryData, MaxNumQueryCountPerPool> results;
+    DxvkBufferSliceHandle slice = m_readback->getSliceHandle();
     
-    // We cannot use VK_QUERY_RESULT_WAIT_BIT here since that
-    // may stall the calling thread indefinitely. Instead, we
-    // just assume that all queries should be available after
-    // waiting for the fence that protects the command buffer.
-    const VkResult status = m_vkd->vkGetQueryPoolResults(
-      m_vkd->device(), m_queryPool, queryIndex, queryCount,
-      sizeof(DxvkQueryData) * queryCount, results.data(),
-      sizeof(DxvkQueryData), VK_QUERY_RESULT_64_BIT);
-    
-    if (status != VK_SUCCESS) {
-      Logger::warn(str::format(
-        "DxvkQueryPool: Failed to get query data for ", queryIndex,
-        ":", queryCount, " with: ", status));
-      
-      // If retrieving query data failed, we need to fake query
-      // data. In case of occlusion queries, we should return a
-      // non-zero value for samples passed, so that games do not
-      // accidentally omit certain geometry because of this.
-      for (uint32_t i = 0; i < queryCount; i++) {
-        results[i] = DxvkQueryData();
-        
-        if (m_queryType == VK_QUERY_TYPE_OCCLUSION)
-          results[i].occlusion.samplesPassed = 1;
-      }
-    }
+    // The wait bit only stalls the GPU, and the queries
+    // have been ended earlier in the same submission.
+    cmd->cmdCopyQueryPoolResults(m_queryPool,
+      queryIndex, queryCount, slice.handle,
+      slice.offset + sizeof(DxvkQueryData) * queryIndex,
+      sizeof(DxvkQueryData),
+      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+  }
+  
+  
+  VkResult DxvkQueryPool::getData(
+          uint32_t          queryIndex,
+          uint32_t          queryCount) {
+    auto results = reinterpret_cast<const DxvkQueryData*>(
+      m_readback->mapPtr(sizeof(DxvkQueryData) * queryIndex));
     
     // Forward query data to the query objects
     for (uint32_t i = 0; i < queryCount; i++) {
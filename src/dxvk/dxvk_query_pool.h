@@ -2,11 +2,13 @@
 
 #include <vector>
 
+#include "dxvk_buffer.h"
 #include "dxvk_query.h"
 
 namespace dxvk {
   
   class DxvkCommandList;
+  class DxvkDevice;
   class DxvkQueryPool;
   
   /**
@@ -27,14 +29,15 @@ namespace dxvk {
    * 
    * Manages a Vulkan query pool. This is used
    * to allocate actual query objects for virtual
-   * query objects.
+   * query objects. Query results are copied to a
+   * host-visible readback buffer on the GPU.
    */
   class DxvkQueryPool : public RcObject {
     
   public:
     
     DxvkQueryPool(
-      const Rc<vk::DeviceFn>& vkd,
+            DxvkDevice*       device,
             VkQueryType       queryType,
             uint32_t          queryCount);
     
@@ -57,9 +60,28 @@ namespace dxvk {
     DxvkQueryHandle allocQuery(
       const DxvkQueryRevision& revision);
     
+    /**
+     * \brief Records commands to resolve queries
+     * 
+     * Copies the results of a range of queries to the
+     * readback buffer. Must be recorded after all the
+     * queries in the range have ended, and outside of
+     * a render pass.
+     * \param [in] cmd Command list
+     * \param [in] queryIndex First query in the range
+     * \param [in] queryCount Number of queries
+     */
+    void recordResolve(
+      const Rc<DxvkCommandList>& cmd,
+            uint32_t          queryIndex,
+            uint32_t          queryCount);
+    
     /**
      * \brief Writes back data for a range of queries
      * 
+     * Reads resolved query data from the readback buffer.
+     * Must only be called after the command list which
+     * resolved the queries has completed execution.
      * \param [in] queryIndex First query in the range
      * \param [in] queryCount Number of queries
      * \returns Query result status
@@ -96,6 +118,8 @@ namespace dxvk {
     VkQueryType m_queryType;
     VkQueryPool m_queryPool = VK_NULL_HANDLE;
     
+    Rc<DxvkBuffer> m_readback;
+    
     std::vector<DxvkQueryRevision> m_queries;
     
     uint32_t m_queryRangeOffset = 0;
@@ -4,9 +4,13 @@
 namespace dxvk {
   
   DxvkSubmissionQueue::DxvkSubmissionQueue(DxvkDevice* device)
-  : m_device(device),
-    m_thread([this] () { threadFunc(); }) {
+  : m_device(device) {
+    uint32_t threadCount = std::min(dxvk::thread::hardware_concurrency() / 4, 2u);
     
+    for (uint32_t i = 0; i < std::max(threadCount, 1u); i++)
+      m_retireThreads.emplace_back([this] () { retireFunc(); });
+    
+    m_thread = dxvk::thread([this] () { threadFunc(); });
   }
   
   
@@ -17,6 +21,15 @@ namespace dxvk {
     
     m_condOnAdd.notify_one();
     m_thread.join();
+    
+    { std::unique_lock<std::mutex> lock(m_retireMutex);
+      m_retireStopped = true;
+    }
+    
+    m_retireCond.notify_all();
+    
+    for (auto& thread : m_retireThreads)
+      thread.join();
   }
   
   
@@ -28,7 +41,7 @@ namespace dxvk {
       });
       
       m_submits += 1;
-      m_entries.push(cmdList);
+      m_entries.push({ cmdList, Clock::now() });
       m_condOnAdd.notify_one();
     }
   }
@@ -38,7 +51,7 @@ namespace dxvk {
     env::setThreadName("dxvk-queue");
 
     while (!m_stopped.load()) {
-      Rc<DxvkCommandList> cmdList;
+      DxvkSubmissionEntry entry;
       
       { std::unique_lock<std::mutex> lock(m_mutex);
         
@@ -47,22 +60,50 @@ namespace dxvk {
         });
         
         if (m_entries.size() != 0) {
-          cmdList = std::move(m_entries.front());
+          entry = std::move(m_entries.front());
           m_entries.pop();
         }
         
         m_condOnTake.notify_one();
       }
       
-      if (cmdList != nullptr) {
-        VkResult status = cmdList->synchronize();
+      if (entry.cmdList != nullptr) {
+        VkResult status;
+        
+        { TraceZone zone("Fence wait");
+          status = entry.cmdList->synchronize();
+        }
         
         if (status == VK_SUCCESS) {
-          cmdList->writeQueryData();
-          cmdList->signalEvents();
-          cmdList->reset();
+          auto t0 = Clock::now();
           
-          m_device->recycleCommandList(cmdList);
+          // Keep a moving average of the submission latency
+          // so that frame pacing can adapt to the GPU load
+          int64_t latency = std::chrono::duration_cast<TimeDiff>(
+            t0 - entry.submitTime).count();
+          
+          m_gpuLatency.store((m_gpuLatency.load() * 7 + latency) / 8);
+          
+          // Make results visible to the application as soon
+          // as possible, and mark resources as no longer in
+          // use. Only releasing the references is deferred.
+          entry.cmdList->writeQueryData();
+          entry.cmdList->signalEvents();
+          entry.cmdList->notifyObjects();
+          
+          if (Tracer::isEnabled()) {
+            entry.cmdList->writeTraceZones(entry.submitTime,
+              m_device->adapter()->deviceProperties().limits.timestampPeriod);
+          }
+          
+          auto t1 = Clock::now();
+          
+          m_signalTime += std::chrono::duration_cast<TimeDiff>(t1 - t0).count();
+          
+          { std::unique_lock<std::mutex> lock(m_retireMutex);
+            m_retireEntries.push(std::move(entry.cmdList));
+            m_retireCond.notify_one();
+          }
         } else {
           Logger::err(str::format(
             "DxvkSubmissionQueue: Failed to sync fence: ",
@@ -74,4 +115,38 @@ namespace dxvk {
     }
   }
   
+  
+  void DxvkSubmissionQueue::retireFunc() {
+    env::setThreadName("dxvk-retire");
+    
+    while (true) {
+      Rc<DxvkCommandList> cmdList;
+      
+      { std::unique_lock<std::mutex> lock(m_retireMutex);
+        
+        m_retireCond.wait(lock, [this] {
+          return m_retireStopped || !m_retireEntries.empty();
+        });
+        
+        if (m_retireEntries.empty())
+          break;
+        
+        cmdList = std::move(m_retireEntries.front());
+        m_retireEntries.pop();
+      }
+      
+      auto t0 = Clock::now();
+      
+      { TraceZone zone("Retire");
+        cmdList->reset();
+        m_device->recycleCommandList(cmdList);
+      }
+      
+      auto t1 = Clock::now();
+      
+      m_retireTime  += std::chrono::duration_cast<TimeDiff>(t1 - t0).count();
+      m_retireCount += 1;
+    }
+  }
+  
 }
\ No newline at end of file
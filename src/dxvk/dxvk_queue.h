@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 #include "../util/thread.h"
 
@@ -12,11 +14,48 @@ namespace dxvk {
   
   class DxvkDevice;
   
+  /**
+   * \brief Submission queue entry
+   * 
+   * Stores the time at which the command list
+   * was submitted so that the queue thread can
+   * measure how long the GPU took to complete it.
+   */
+  struct DxvkSubmissionEntry {
+    Rc<DxvkCommandList>                             cmdList;
+    std::chrono::high_resolution_clock::time_point  submitTime;
+  };
+  
+  /**
+   * \brief Submission queue statistics
+   * 
+   * Cumulative timings of the submission queue.
+   * Signal time is the time between observing that
+   * a fence got signaled and signaling the events
+   * and queries of the command list, while retire
+   * time is spent releasing resources afterwards.
+   */
+  struct DxvkSubmissionStats {
+    uint64_t retireCount  = 0;
+    uint64_t signalTimeUs = 0;
+    uint64_t retireTimeUs = 0;
+  };
+  
   /**
    * \brief Submission queue
+   * 
+   * Uses one thread to wait for submitted command lists
+   * to complete in order, which immediately writes back
+   * query data, signals events and marks all tracked
+   * resources as unused. Resetting the command list,
+   * which drops the references to tracked resources and
+   * may destroy them, is done by a small pool of
+   * retirement threads so that it does not delay the
+   * next fence.
    */
   class DxvkSubmissionQueue {
-    
+    using Clock    = std::chrono::high_resolution_clock;
+    using TimeDiff = std::chrono::microseconds;
   public:
     
     DxvkSubmissionQueue(DxvkDevice* device);
@@ -33,6 +72,30 @@ namespace dxvk {
       return m_submits.load();
     }
     
+    /**
+     * \brief Average GPU latency
+     * 
+     * Moving average of the time between submitting
+     * a command list and the queue thread observing
+     * its completion on the GPU.
+     * \returns GPU latency, in microseconds
+     */
+    TimeDiff gpuLatency() const {
+      return TimeDiff(m_gpuLatency.load());
+    }
+    
+    /**
+     * \brief Queries submission statistics
+     * \returns Cumulative queue timings
+     */
+    DxvkSubmissionStats getStats() const {
+      DxvkSubmissionStats result;
+      result.retireCount  = m_retireCount.load();
+      result.signalTimeUs = m_signalTime.load();
+      result.retireTimeUs = m_retireTime.load();
+      return result;
+    }
+    
     /**
      * \brief Submits a command list
      * 
@@ -51,15 +114,28 @@ namespace dxvk {
     
     std::atomic<bool>       m_stopped = { false };
     std::atomic<uint32_t>   m_submits = { 0u };
+    std::atomic<int64_t>    m_gpuLatency = { 0ll };
+    
+    std::atomic<uint64_t>   m_retireCount = { 0ull };
+    std::atomic<uint64_t>   m_signalTime  = { 0ull };
+    std::atomic<uint64_t>   m_retireTime  = { 0ull };
     
     std::mutex              m_mutex;
     std::condition_variable m_condOnAdd;
     std::condition_variable m_condOnTake;
-    std::queue<Rc<DxvkCommandList>> m_entries;
+    std::queue<DxvkSubmissionEntry> m_entries;
     dxvk::thread             m_thread;
     
+    bool                    m_retireStopped = false;
+    std::mutex              m_retireMutex;
+    std::condition_variable m_retireCond;
+    std::queue<Rc<DxvkCommandList>> m_retireEntries;
+    std::vector<dxvk::thread>       m_retireThreads;
+    
     void threadFunc();
     
+    void retireFunc();
+    
   };
   
 }
@@ -31,9 +31,30 @@ namespace dxvk {
     void acquire() { m_useCount += 1; }
     void release() { m_useCount -= 1; }
     
+    /**
+     * \brief Marks resource as tracked
+     * 
+     * Stores the ID of the lifetime tracker that
+     * last tracked this resource. Tracker IDs are
+     * unique, so if this returns \c false, the given
+     * tracker already holds a reference to the
+     * resource and does not need to add another one.
+     * \param [in] trackingId Lifetime tracker ID
+     * \returns \c true if the resource was not
+     *    yet tracked by the given tracker
+     */
+    bool markTracked(uint64_t trackingId) {
+      if (m_trackingId.load(std::memory_order_relaxed) == trackingId)
+        return false;
+      
+      m_trackingId.store(trackingId, std::memory_order_relaxed);
+      return true;
+    }
+    
   private:
     
-    std::atomic<uint32_t> m_useCount = { 0u };
+    std::atomic<uint32_t> m_useCount   = { 0u };
+    std::atomic<uint64_t> m_trackingId = { 0ull };
     
   };
   
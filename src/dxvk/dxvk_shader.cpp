@@ -85,15 +85,28 @@ namespace dxvk {
           DxvkShaderConstData&&   constData)
   : m_stage(stage), m_code(code), m_interface(iface),
     m_options(options), m_constData(std::move(constData)) {
-    // Write back resource slot infos
-    for (uint32_t i = 0; i < slotCount; i++)
-      m_slots.push_back(slotInfos[i]);
+    // Pre-compute the slot mapping for this shader stage
+    // so that pipeline creation only needs to merge them
+    for (uint32_t i = 0; i < slotCount; i++) {
+      m_slotMapping.defineSlot(
+        slotInfos[i].slot, slotInfos[i].type,
+        slotInfos[i].view, m_stage,
+        slotInfos[i].access);
+    }
     
     // Gather the offsets where the binding IDs
     // are stored so we can quickly remap them.
     uint32_t o1VarId = 0;
     
     for (auto ins : m_code) {
+      if (ins.opCode() == spv::OpCapability) {
+        if (ins.arg(1) == spv::CapabilitySampleRateShading)
+          m_flags.set(DxvkShaderFlag::HasSampleRateShading);
+        
+        if (ins.arg(1) == spv::CapabilityTransformFeedback)
+          m_flags.set(DxvkShaderFlag::HasTransformFeedback);
+      }
+      
       if (ins.opCode() == spv::OpDecorate) {
         if (ins.arg(2) == spv::DecorationBinding
          || ins.arg(2) == spv::DecorationSpecId)
@@ -116,24 +129,9 @@ namespace dxvk {
   }
   
   
-  bool DxvkShader::hasCapability(spv::Capability cap) {
-    for (auto ins : m_code) {
-      // OpCapability instructions come first
-      if (ins.opCode() != spv::OpCapability)
-        return false;
-      
-      if (ins.arg(1) == cap)
-        return true;
-    }
-    
-    return false;
-  }
-  
-  
   void DxvkShader::defineResourceSlots(
           DxvkDescriptorSlotMapping& mapping) const {
-    for (const auto& slot : m_slots)
-      mapping.defineSlot(slot.slot, slot.type, slot.view, m_stage, slot.access);
+    mapping.merge(m_slotMapping);
   }
   
   
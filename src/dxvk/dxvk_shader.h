@@ -21,6 +21,12 @@ namespace dxvk {
    * shaders to access some pipeline state like D3D
    * shaders do. They need to be filled in by the
    * implementation at pipeline compilation time.
+   * 
+   * Constants in the device state range are not
+   * derived from the pipeline state vector, but
+   * set once by the client API via the device.
+   * This allows shaders to branch on them without
+   * baking the behaviour into the SPIR-V code.
    */
   enum class DxvkSpecConstantId : uint32_t {
     /// Special constant ranges that do not count
@@ -31,12 +37,32 @@ namespace dxvk {
     SpecConstantRangeStart      = ColorComponentMappings + MaxNumRenderTargets * 4,
     RasterizerSampleCount       = SpecConstantRangeStart + 0,
 
+    // Specialization constants for device state
+    StrictDivision              = SpecConstantRangeStart + 1,
+    ZeroInitWorkgroupMemory     = SpecConstantRangeStart + 2,
+
     /// Lowest and highest known spec constant IDs
     SpecConstantIdMin           = RasterizerSampleCount,
-    SpecConstantIdMax           = RasterizerSampleCount,
+    SpecConstantIdMax           = ZeroInitWorkgroupMemory,
   };
   
   
+  /**
+   * \brief Shader properties
+   * 
+   * Properties that are relevant when creating
+   * pipelines. These are computed once when the
+   * shader object is created so that pipeline
+   * creation does not need to scan the code.
+   */
+  enum class DxvkShaderFlag : uint32_t {
+    HasSampleRateShading,
+    HasTransformFeedback,
+  };
+
+  using DxvkShaderFlags = Flags<DxvkShaderFlag>;
+
+
   /**
    * \brief Shader interface slots
    * 
@@ -143,23 +169,21 @@ namespace dxvk {
     }
     
     /**
-     * \brief Checks whether a capability is enabled
-     * 
-     * If the shader contains an \c OpCapability
-     * instruction with the given capability, it
-     * is considered enabled. This may be required
-     * to correctly set up certain pipeline states.
-     * \param [in] cap The capability to check
-     * \returns \c true if \c cap is enabled
+     * \brief Shader properties
+     * \returns Shader flags
      */
-    bool hasCapability(spv::Capability cap);
+    DxvkShaderFlags flags() const {
+      return m_flags;
+    }
     
     /**
      * \brief Adds resource slots definitions to a mapping
      * 
      * Used to generate the exact descriptor set layout when
      * compiling a graphics or compute pipeline. Slot indices
-     * have to be mapped to actual binding numbers.
+     * have to be mapped to actual binding numbers. The slot
+     * mapping for this shader stage is computed when the
+     * shader is created, so this only needs to merge it.
      */
     void defineResourceSlots(
             DxvkDescriptorSlotMapping& mapping) const;
@@ -244,9 +268,10 @@ namespace dxvk {
   private:
     
     VkShaderStageFlagBits m_stage;
+    DxvkShaderFlags       m_flags;
     SpirvCodeBuffer       m_code;
     
-    std::vector<DxvkResourceSlot> m_slots;
+    DxvkDescriptorSlotMapping     m_slotMapping;
     std::vector<size_t>           m_idOffsets;
     DxvkInterfaceSlots            m_interface;
     DxvkShaderOptions             m_options;
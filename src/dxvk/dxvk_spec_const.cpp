@@ -1,16 +1,12 @@
 #include "dxvk_spec_const.h"
 
-#define SET_CONSTANT_ENTRY(specId, member)  \
-  this->setConstantEntry(specId,            \
-    offsetof(DxvkSpecConstantData, member), \
-    sizeof(DxvkSpecConstantData::member))
-
 namespace dxvk {
   
   DxvkSpecConstantMap g_specConstantMap;
   
   DxvkSpecConstantMap::DxvkSpecConstantMap() {
-    SET_CONSTANT_ENTRY(DxvkSpecConstantId::RasterizerSampleCount, rasterizerSampleCount);
+    for (uint32_t i = 0; i < MaxNumSpecConstants; i++)
+      this->setConstantEntry(DxvkSpecConstantId(uint32_t(DxvkSpecConstantId::SpecConstantIdMin) + i));
 
     for (uint32_t i = 0; i < MaxNumActiveBindings; i++)
       this->setBindingEntry(i);
@@ -21,14 +17,14 @@ namespace dxvk {
   
   
   void DxvkSpecConstantMap::setConstantEntry(
-          DxvkSpecConstantId  specId,
-          uint32_t            offset,
-          uint32_t            size) {
+          DxvkSpecConstantId  specId) {
+    uint32_t index = uint32_t(specId) - uint32_t(DxvkSpecConstantId::SpecConstantIdMin);
+    
     VkSpecializationMapEntry entry;
     entry.constantID = uint32_t(specId);
-    entry.offset     = offset;
-    entry.size       = size;
-    m_mapEntries[uint32_t(specId) - uint32_t(DxvkSpecConstantId::SpecConstantIdMin)] = entry;
+    entry.offset     = sizeof(uint32_t) * index + offsetof(DxvkSpecConstantData, specConstants);
+    entry.size       = sizeof(uint32_t);
+    m_mapEntries[index] = entry;
   }
 
 
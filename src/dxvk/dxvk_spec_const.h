@@ -17,9 +17,57 @@ namespace dxvk {
    * the shaders.
    */
   struct DxvkSpecConstantData {
-    uint32_t rasterizerSampleCount;
+    uint32_t specConstants[MaxNumSpecConstants];
     uint32_t outputMappings[MaxNumRenderTargets * 4];
     VkBool32 activeBindings[MaxNumActiveBindings];
+
+    void set(DxvkSpecConstantId specId, uint32_t value) {
+      specConstants[uint32_t(specId) - uint32_t(DxvkSpecConstantId::SpecConstantIdMin)] = value;
+    }
+  };
+
+
+  /**
+   * \brief Device spec constant values
+   * 
+   * Stores the values of spec constants which are not
+   * derived from pipeline state. These are set by the
+   * client API before any pipelines are compiled.
+   */
+  class DxvkSpecConstantValues {
+
+  public:
+
+    DxvkSpecConstantValues() {
+      m_values.fill(0u);
+    }
+
+    /**
+     * \brief Sets value of a spec constant
+     * 
+     * \param [in] specId Spec constant ID
+     * \param [in] value Spec constant value
+     */
+    void set(DxvkSpecConstantId specId, uint32_t value) {
+      m_values[uint32_t(specId) - uint32_t(DxvkSpecConstantId::SpecConstantIdMin)] = value;
+    }
+
+    /**
+     * \brief Writes values to spec constant data
+     * 
+     * Should be called before pipeline state-based
+     * values are written to the spec constant data.
+     * \param [out] data Spec constant data
+     */
+    void apply(DxvkSpecConstantData& data) const {
+      for (uint32_t i = 0; i < MaxNumSpecConstants; i++)
+        data.specConstants[i] = m_values[i];
+    }
+
+  private:
+
+    std::array<uint32_t, MaxNumSpecConstants> m_values;
+
   };
   
   
@@ -62,9 +110,7 @@ namespace dxvk {
       MaxNumRenderTargets * 4> m_mapEntries;
     
     void setConstantEntry(
-            DxvkSpecConstantId  specId,
-            uint32_t            offset,
-            uint32_t            size);
+            DxvkSpecConstantId  specId);
     
     void setBindingEntry(
             uint32_t            binding);
@@ -247,7 +247,7 @@ namespace dxvk {
         const auto& entry = m_entries[e->second];
 
         auto rp = m_passManager->getRenderPass(entry.format);
-        pipeline->getPipelineHandle(entry.gpState, *rp);
+        pipeline->getPipelineHandle(entry.gpState, *rp, nullptr);
       }
     } else {
       auto pipeline = m_pipeManager->createComputePipeline(item.cs);
@@ -255,7 +255,7 @@ namespace dxvk {
 
       for (auto e = entries.first; e != entries.second; e++) {
         const auto& entry = m_entries[e->second];
-        pipeline->getPipelineHandle(entry.cpState);
+        pipeline->getPipelineHandle(entry.cpState, nullptr);
       }
     }
   }
@@ -14,12 +14,27 @@ namespace dxvk {
     CmdDrawCalls,             ///< Number of draw calls
     CmdDispatchCalls,         ///< Number of compute calls
     CmdRenderPassCount,       ///< Number of render passes
+    CmdClearsElided,          ///< Number of clears folded into render passes or dropped
+    CmdTrackedResources,      ///< Number of resources tracked by command lists
+    CmdBarrierCount,          ///< Number of pipeline barriers
+    CmdDescriptorSetCount,    ///< Number of descriptor set allocations
+    CsBusyTime,               ///< Time the CS thread spent executing commands, in us
+    CsSyncTime,               ///< Time spent waiting for the CS thread, in us
+    GpuSyncTime,              ///< Time spent waiting for resources to become idle, in us
     MemoryAllocationCount,    ///< Number of memory allocations
     MemoryAllocated,          ///< Amount of memory allocated
     MemoryUsed,               ///< Amount of memory used
+    MemorySpare,              ///< Amount of memory held in unused buffer slices
     PipeCountGraphics,        ///< Number of graphics pipelines
     PipeCountCompute,         ///< Number of compute pipelines
-    QueueSubmitCount,         ///< Number of command buffer submissions
+    PipeCompileCount,         ///< Number of pipelines compiled on the render thread
+    PipeCompileTime,          ///< Time spent compiling pipelines on the render thread, in us
+    QueueSubmitCount,         ///< Number of queue submit calls
+    QueueCmdListCount,        ///< Number of submitted command lists
+    QueueSubmitTime,          ///< CPU time spent in queue submissions, in us
+    QueueRetireCount,         ///< Number of retired command lists
+    QueueSignalTime,          ///< Time between fence and event signal, in us
+    QueueRetireTime,          ///< Time spent retiring command lists, in us
     QueuePresentCount,        ///< Number of present calls / frames
     NumCounters,              ///< Number of counters available
   };
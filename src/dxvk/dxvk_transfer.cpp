@@ -0,0 +1,150 @@
+#include <cstring>
+
+#include "dxvk_device.h"
+#include "dxvk_transfer.h"
+
+namespace dxvk {
+  
+  DxvkTransferContext::DxvkTransferContext(
+    const Rc<DxvkDevice>&           device)
+  : m_device  (device),
+    m_srcQueue(device->transferQueue().queueFamily),
+    m_dstQueue(device->graphicsQueue().queueFamily) {
+    
+  }
+  
+  
+  DxvkTransferContext::~DxvkTransferContext() {
+    
+  }
+  
+  
+  void DxvkTransferContext::beginRecording(
+    const Rc<DxvkCommandList>&      cmdList) {
+    m_cmd = cmdList;
+    m_cmd->beginRecording();
+  }
+  
+  
+  void DxvkTransferContext::flushCommandList(
+    const Rc<DxvkContext>&          context) {
+    if (!m_uploadCount)
+      return;
+    
+    m_releases.recordCommands(m_cmd);
+    m_cmd->endRecording();
+    
+    VkSemaphore semaphore = m_device->submitTransferCommandList(
+      std::exchange(m_cmd, nullptr));
+    
+    // The command list containing the acquire barriers must
+    // wait for the transfer queue, otherwise the barriers and
+    // any subsequent use of the resources are not ordered
+    // with the copies.
+    context->acquireResources(semaphore,
+      m_acquires, m_acquiredResources);
+    
+    this->beginRecording(
+      m_device->createTransferCommandList());
+    
+    m_uploadCount = 0;
+  }
+  
+  
+  void DxvkTransferContext::uploadBuffer(
+    const Rc<DxvkBuffer>&           buffer,
+          VkDeviceSize              offset,
+          VkDeviceSize              size,
+    const void*                     data) {
+    auto bufferSlice = buffer->getSliceHandle(offset, size);
+    
+    const DxvkStagingBufferSlice slice = m_cmd->stagedAlloc(size);
+    std::memcpy(slice.mapPtr, data, size);
+    
+    m_cmd->stagedBufferCopy(
+      bufferSlice.handle,
+      bufferSlice.offset,
+      bufferSlice.length,
+      slice);
+    
+    m_releases.releaseBuffer(m_acquires, bufferSlice,
+      m_srcQueue,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_ACCESS_TRANSFER_WRITE_BIT,
+      m_dstQueue,
+      buffer->info().stages,
+      buffer->info().access);
+    
+    m_cmd->trackResource(buffer);
+    m_acquiredResources.push_back(buffer);
+    m_uploadCount += 1;
+  }
+  
+  
+  void DxvkTransferContext::uploadImage(
+    const Rc<DxvkImage>&            image,
+    const VkImageSubresourceLayers& subresources,
+          VkExtent3D                imageExtent,
+    const void*                     data,
+          VkDeviceSize              pitchPerRow,
+          VkDeviceSize              pitchPerLayer) {
+    const DxvkFormatInfo* formatInfo = image->formatInfo();
+    
+    VkExtent3D elementCount = util::computeBlockCount(
+      imageExtent, formatInfo->blockSize);
+    elementCount.depth *= subresources.layerCount;
+    
+    const DxvkStagingBufferSlice slice = m_cmd->stagedAlloc(
+      formatInfo->elementSize * util::flattenImageExtent(elementCount));
+    
+    util::packImageData(
+      reinterpret_cast<char*>(slice.mapPtr),
+      reinterpret_cast<const char*>(data),
+      elementCount, formatInfo->elementSize,
+      pitchPerRow, pitchPerLayer);
+    
+    auto subresourceRange = vk::makeSubresourceRange(subresources);
+    subresourceRange.aspectMask = formatInfo->aspectMask;
+    
+    VkImageLayout imageLayoutTransfer = image->pickLayout(
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    
+    m_transitions.accessImage(
+      image, subresourceRange,
+      VK_IMAGE_LAYOUT_UNDEFINED, 0, 0,
+      imageLayoutTransfer,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_ACCESS_TRANSFER_WRITE_BIT);
+    
+    m_transitions.recordCommands(m_cmd);
+    
+    VkBufferImageCopy region;
+    region.bufferOffset       = slice.offset;
+    region.bufferRowLength    = 0;
+    region.bufferImageHeight  = 0;
+    region.imageSubresource   = subresources;
+    region.imageOffset        = VkOffset3D { 0, 0, 0 };
+    region.imageExtent        = imageExtent;
+    
+    m_cmd->stagedBufferImageCopy(image->handle(),
+      imageLayoutTransfer, region, slice);
+    
+    // The graphics queue performs the transition into
+    // the default layout as part of the acquire barrier
+    m_releases.releaseImage(m_acquires,
+      image, subresourceRange,
+      m_srcQueue,
+      imageLayoutTransfer,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_ACCESS_TRANSFER_WRITE_BIT,
+      m_dstQueue,
+      image->info().layout,
+      image->info().stages,
+      image->info().access);
+    
+    m_cmd->trackResource(image);
+    m_acquiredResources.push_back(image);
+    m_uploadCount += 1;
+  }
+  
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "dxvk_barrier.h"
+#include "dxvk_cmdlist.h"
+
+namespace dxvk {
+  
+  class DxvkContext;
+  class DxvkDevice;
+  
+  /**
+   * \brief Transfer context
+   * 
+   * Records resource uploads into command lists for the
+   * dedicated transfer queue, so that large uploads can
+   * run on the DMA engine while the graphics queue keeps
+   * rendering. Ownership of all uploaded resources gets
+   * transferred to the graphics queue on submission.
+   */
+  class DxvkTransferContext : public RcObject {
+    
+  public:
+    
+    DxvkTransferContext(
+      const Rc<DxvkDevice>&           device);
+    ~DxvkTransferContext();
+    
+    /**
+     * \brief Begins command buffer recording
+     * \param [in] cmdList Target command list
+     */
+    void beginRecording(
+      const Rc<DxvkCommandList>&      cmdList);
+    
+    /**
+     * \brief Submits pending uploads
+     * 
+     * Submits the current command list to the transfer
+     * queue and records the matching acquire barriers
+     * into the given graphics context, whose current
+     * command list will wait for the transfer queue.
+     * The graphics context must be flushed before the
+     * resources can be used by any other context.
+     * \param [in] context Graphics context
+     */
+    void flushCommandList(
+      const Rc<DxvkContext>&          context);
+    
+    /**
+     * \brief Uploads data to a buffer
+     * 
+     * The buffer must not have been used
+     * on the graphics queue before.
+     * \param [in] buffer Destination buffer
+     * \param [in] offset Offset, in bytes
+     * \param [in] size Number of bytes to write
+     * \param [in] data Data to upload
+     */
+    void uploadBuffer(
+      const Rc<DxvkBuffer>&           buffer,
+            VkDeviceSize              offset,
+            VkDeviceSize              size,
+      const void*                     data);
+    
+    /**
+     * \brief Uploads data to an image
+     * 
+     * Behaves like \ref DxvkContext::updateImage, except
+     * that the region must cover entire subresources and
+     * that their previous contents are discarded.
+     * \param [in] image Destination image
+     * \param [in] subresources Image subresources
+     * \param [in] imageExtent Subresource extent
+     * \param [in] data Data to upload
+     * \param [in] pitchPerRow Row pitch of the data
+     * \param [in] pitchPerLayer Layer pitch of the data
+     */
+    void uploadImage(
+      const Rc<DxvkImage>&            image,
+      const VkImageSubresourceLayers& subresources,
+            VkExtent3D                imageExtent,
+      const void*                     data,
+            VkDeviceSize              pitchPerRow,
+            VkDeviceSize              pitchPerLayer);
+    
+  private:
+    
+    const Rc<DxvkDevice>  m_device;
+    
+    Rc<DxvkCommandList>   m_cmd;
+    
+    uint32_t              m_srcQueue;
+    uint32_t              m_dstQueue;
+    
+    DxvkBarrierSet        m_transitions;
+    DxvkBarrierSet        m_releases;
+    DxvkBarrierSet        m_acquires;
+    
+    std::vector<Rc<DxvkResource>> m_acquiredResources;
+    
+    uint32_t              m_uploadCount = 0;
+    
+  };
+  
+}
@@ -3,8 +3,127 @@
 #include "dxvk_format.h"
 #include "dxvk_util.h"
 
+#include "../util/util_cpu.h"
+
+#ifdef DXVK_ARCH_X86
+  #include <immintrin.h>
+#endif
+
 namespace dxvk::util {
   
+  using StreamCopyFn = void (*)(char*, const char*, size_t);
+  
+#ifdef DXVK_ARCH_X86
+  DXVK_TARGET_SSE2
+  static void streamCopySse2(
+          char*             dst,
+    const char*             src,
+          size_t            size) {
+    size_t head = std::min(size, size_t(-reinterpret_cast<uintptr_t>(dst) & 0xF));
+    std::memcpy(dst, src, head);
+    
+    dst  += head;
+    src  += head;
+    size -= head;
+    
+    for (; size >= 64; size -= 64, dst += 64, src += 64) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 0);
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 1);
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 2);
+      __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 3);
+      
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 0, a);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 1, b);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 2, c);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 3, d);
+    }
+    
+    for (; size >= 16; size -= 16, dst += 16, src += 16) {
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+    
+    std::memcpy(dst, src, size);
+  }
+  
+  
+  DXVK_TARGET_AVX2
+  static void streamCopyAvx2(
+          char*             dst,
+    const char*             src,
+          size_t            size) {
+    size_t head = std::min(size, size_t(-reinterpret_cast<uintptr_t>(dst) & 0x1F));
+    std::memcpy(dst, src, head);
+    
+    dst  += head;
+    src  += head;
+    size -= head;
+    
+    for (; size >= 128; size -= 128, dst += 128, src += 128) {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 0);
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 1);
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 2);
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 3);
+      
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 0, a);
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 1, b);
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 2, c);
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst) + 3, d);
+    }
+    
+    for (; size >= 32; size -= 32, dst += 32, src += 32) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+    }
+    
+    std::memcpy(dst, src, size);
+  }
+#endif
+  
+  
+  static void streamCopyScalar(
+          char*             dst,
+    const char*             src,
+          size_t            size) {
+    std::memcpy(dst, src, size);
+  }
+  
+  
+  static StreamCopyFn selectStreamCopy() {
+#ifdef DXVK_ARCH_X86
+    const cpu::Features& features = cpu::getFeatures();
+    
+    if (features.avx2)
+      return &streamCopyAvx2;
+    
+    if (features.sse2)
+      return &streamCopySse2;
+#endif
+    
+    return &streamCopyScalar;
+  }
+  
+  
+  void streamCopy(
+          void*             dstData,
+    const void*             srcData,
+          size_t            size) {
+    static const StreamCopyFn s_streamCopy = selectStreamCopy();
+    
+    s_streamCopy(
+      reinterpret_cast<char*>(dstData),
+      reinterpret_cast<const char*>(srcData), size);
+  }
+  
+  
+  void streamFence() {
+#ifdef DXVK_ARCH_X86
+    if (cpu::getFeatures().sse2)
+      _mm_sfence();
+#endif
+  }
+  
+  
   VkPipelineStageFlags pipelineStages(
           VkShaderStageFlags shaderStages) {
     VkPipelineStageFlags result = 0;
@@ -52,12 +171,21 @@ namespace dxvk::util {
     const bool directCopy = ((bytesPerRow   == pitchPerRow  ) || (blockCount.height == 1))
                          && ((bytesPerLayer == pitchPerLayer) || (blockCount.depth  == 1));
     
+    // The destination is usually a staging buffer that the CPU
+    // will not read back, so large uploads bypass the cache.
+    // Small uploads are likely to still be in the cache when
+    // the data is consumed, so a plain copy is faster there.
+    const bool streaming = bytesTotal >= StreamCopyThreshold;
+    
+    auto copyFn = streaming ? &streamCopy
+      : [] (void* dst, const void* src, size_t size) { std::memcpy(dst, src, size); };
+    
     if (directCopy) {
-      std::memcpy(dstData, srcData, bytesTotal);
+      copyFn(dstData, srcData, bytesTotal);
     } else {
       for (uint32_t i = 0; i < blockCount.depth; i++) {
         for (uint32_t j = 0; j < blockCount.height; j++) {
-          std::memcpy(
+          copyFn(
             dstData + j * bytesPerRow,
             srcData + j * pitchPerRow,
             bytesPerRow);
@@ -67,6 +195,9 @@ namespace dxvk::util {
         dstData += bytesPerLayer;
       }
     }
+    
+    if (streaming)
+      streamFence();
   }
   
   
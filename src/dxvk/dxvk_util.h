@@ -21,9 +21,45 @@ namespace dxvk::util {
    */
   uint32_t computeMipLevelCount(VkExtent3D imageSize);
   
+  /**
+   * \brief Minimum size for non-temporal image uploads
+   * 
+   * Image data uploads of at least this many bytes
+   * will use non-temporal stores if supported.
+   */
+  constexpr size_t StreamCopyThreshold = 256ull << 10;
+  
+  /**
+   * \brief Copies memory with non-temporal stores
+   * 
+   * Uses the widest vector instructions supported by the
+   * CPU, as detected at runtime, and falls back to a plain
+   * \c memcpy otherwise. The destination will not be in
+   * the cache afterwards, so this should only be used for
+   * large amounts of data that the CPU does not read back.
+   * Call \ref streamFence before handing the destination
+   * memory off to another thread or to the GPU.
+   * \param [in] dstData Destination pointer
+   * \param [in] srcData Source pointer
+   * \param [in] size Number of bytes to copy
+   */
+  void streamCopy(
+          void*             dstData,
+    const void*             srcData,
+          size_t            size);
+  
+  /**
+   * \brief Orders non-temporal stores
+   * 
+   * Makes previous stores issued by \ref streamCopy
+   * globally visible before any subsequent stores.
+   */
+  void streamFence();
+  
   /**
    * \brief Writes tightly packed image data to a buffer
    * 
+   * Large uploads use \ref streamCopy internally.
    * \param [in] dstData Destination buffer pointer
    * \param [in] srcData Pointer to source data
    * \param [in] blockCount Number of blocks to copy
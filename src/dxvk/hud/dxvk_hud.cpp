@@ -48,6 +48,11 @@ namespace dxvk::hud {
   }
   
   
+  void Hud::updatePacing(int64_t errorUs) {
+    m_hudFramerate.updatePacing(errorUs);
+  }
+  
+  
   void Hud::render(const Rc<DxvkContext>& ctx, VkExtent2D surfaceSize) {
     HudUniformData uniformData;
     uniformData.surfaceSize = surfaceSize;
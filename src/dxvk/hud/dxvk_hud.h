@@ -44,6 +44,16 @@ namespace dxvk::hud {
      */
     void update();
 
+    /**
+     * \brief Update frame pacing data
+     * 
+     * Adds a data point to the frame pacing
+     * graph. Should be called once per frame
+     * if a frame rate limit is in effect.
+     * \param [in] errorUs Pacing error, in us
+     */
+    void updatePacing(int64_t errorUs);
+
     /**
      * \brief Render HUD
      * 
@@ -14,6 +14,11 @@ namespace dxvk::hud {
     { "memory",       HudElement::StatMemory        },
     { "version",      HudElement::DxvkVersion       },
     { "api",          HudElement::DxvkClientApi     },
+    { "pacing",       HudElement::FramePacing       },
+    { "csthread",     HudElement::StatCsThread      },
+    { "compiles",     HudElement::StatCompiles      },
+    { "barriers",     HudElement::StatBarriers      },
+    { "descriptors",  HudElement::StatDescriptors   },
   }};
   
   
@@ -46,7 +51,7 @@ namespace dxvk::hud {
         
         if (element != g_hudElements.cend()) {
           this->elements.set(element->second);
-          Logger::debug(str::format("Hud: Enabled ", configPart));
+          Logger::log(LogLevel::Debug, "Hud: Enabled ", configPart);
         }
         
         pos = end + 1;
@@ -20,6 +20,11 @@ namespace dxvk::hud {
     StatMemory        = 6,
     DxvkVersion       = 7,
     DxvkClientApi     = 8,
+    FramePacing       = 9,
+    StatCsThread      = 10,
+    StatCompiles      = 11,
+    StatBarriers      = 12,
+    StatDescriptors   = 13,
   };
   
   using HudElements = Flags<HudElement>;
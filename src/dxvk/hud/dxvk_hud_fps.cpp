@@ -42,6 +42,12 @@ namespace dxvk::hud {
   }
   
   
+  void HudFps::updatePacing(int64_t errorUs) {
+    m_pacingPoints[m_pacingPointId] = float(errorUs);
+    m_pacingPointId = (m_pacingPointId + 1) % NumDataPoints;
+  }
+  
+  
   HudPos HudFps::render(
     const Rc<DxvkContext>&  context,
           HudRenderer&      renderer,
@@ -56,6 +62,11 @@ namespace dxvk::hud {
         context, renderer, position);
     }
     
+    if (m_elements.test(HudElement::FramePacing)) {
+      position = this->renderPacingGraph(
+        context, renderer, position);
+    }
+    
     return position;
   }
   
@@ -130,4 +141,59 @@ namespace dxvk::hud {
     return HudPos { position.x, position.y + 66.0f };
   }
   
+  
+  HudPos HudFps::renderPacingGraph(
+    const Rc<DxvkContext>&  context,
+          HudRenderer&      renderer,
+          HudPos            position) {
+    std::array<HudVertex, NumDataPoints * 2> vData;
+    
+    // Errors of 2ms or more use the full bar height
+    const float maxUs = 2'000.0f;
+    
+    // Ten times the maximum absolute error in
+    // milliseconds, and the average error
+    uint32_t maxMs = 0;
+    float    sumUs = 0.0f;
+    
+    // Late frames are drawn upwards in red,
+    // early frames downwards in blue
+    for (uint32_t i = 0; i < NumDataPoints; i++) {
+      float us = m_pacingPoints[(m_pacingPointId + i) % NumDataPoints];
+      
+      maxMs  = std::max(maxMs, uint32_t(std::abs(us) / 100.0f));
+      sumUs += std::abs(us);
+      
+      float a = std::min(std::abs(us) / maxUs, 1.0f);
+      
+      HudTexCoord tc = { 0u, 0u };
+      HudColor color = us >= 0.0f
+        ? HudColor { 1.0f, 1.0f - a, 1.0f - a, 1.0f }
+        : HudColor { 1.0f - a, 1.0f - a, 1.0f, 1.0f };
+      
+      float x = position.x + float(i);
+      float y = position.y + 24.0f;
+      float h = std::max(20.0f * a, 1.0f);
+      
+      vData[2 * i + 0] = HudVertex { { x, y     }, tc, color };
+      vData[2 * i + 1] = HudVertex { { x, us >= 0.0f ? y - h : y + h }, tc, color };
+    }
+    
+    renderer.drawLines(context, vData.size(), vData.data());
+    
+    uint32_t avgMs = uint32_t(sumUs / float(NumDataPoints * 100));
+    
+    renderer.drawText(context, 14.0f,
+      { position.x, position.y + 64.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      str::format("pacing avg: ", avgMs / 10, ".", avgMs % 10, " ms"));
+    
+    renderer.drawText(context, 14.0f,
+      { position.x + 150.0f, position.y + 64.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      str::format("max: ", maxMs / 10, ".", maxMs % 10, " ms"));
+    
+    return HudPos { position.x, position.y + 86.0f };
+  }
+  
 }
\ No newline at end of file
@@ -26,6 +26,8 @@ namespace dxvk::hud {
     
     void update();
     
+    void updatePacing(int64_t errorUs);
+    
     HudPos render(
       const Rc<DxvkContext>&  context,
             HudRenderer&      renderer,
@@ -44,6 +46,9 @@ namespace dxvk::hud {
     std::array<float, NumDataPoints>  m_dataPoints  = {};
     uint32_t                          m_dataPointId = 0;
     
+    std::array<float, NumDataPoints>  m_pacingPoints  = {};
+    uint32_t                          m_pacingPointId = 0;
+    
     HudPos renderFpsText(
       const Rc<DxvkContext>&  context,
             HudRenderer&      renderer,
@@ -54,6 +59,11 @@ namespace dxvk::hud {
             HudRenderer&      renderer,
             HudPos            position);
     
+    HudPos renderPacingGraph(
+      const Rc<DxvkContext>&  context,
+            HudRenderer&      renderer,
+            HudPos            position);
+    
   };
   
 }
\ No newline at end of file
@@ -20,6 +20,12 @@ namespace dxvk::hud {
     DxvkStatCounters nextCounters = device->getStatCounters();
     m_diffCounters = nextCounters.diff(m_prevCounters);
     m_prevCounters = nextCounters;
+    
+    // Wall time since the last update, used to compute
+    // how busy the CS thread was during that interval
+    auto now = std::chrono::high_resolution_clock::now();
+    m_diffTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(now - m_prevUpdate).count();
+    m_prevUpdate = now;
   }
   
   
@@ -39,6 +45,18 @@ namespace dxvk::hud {
     if (m_elements.test(HudElement::StatMemory))
       position = this->printMemoryStats(context, renderer, position);
     
+    if (m_elements.test(HudElement::StatCsThread))
+      position = this->printCsThreadStats(context, renderer, position);
+    
+    if (m_elements.test(HudElement::StatCompiles))
+      position = this->printCompileStats(context, renderer, position);
+    
+    if (m_elements.test(HudElement::StatBarriers))
+      position = this->printBarrierStats(context, renderer, position);
+    
+    if (m_elements.test(HudElement::StatDescriptors))
+      position = this->printDescriptorStats(context, renderer, position);
+    
     return position;
   }
   
@@ -52,10 +70,12 @@ namespace dxvk::hud {
     const uint64_t gpCalls = m_diffCounters.getCtr(DxvkStatCounter::CmdDrawCalls)       / frameCount;
     const uint64_t cpCalls = m_diffCounters.getCtr(DxvkStatCounter::CmdDispatchCalls)   / frameCount;
     const uint64_t rpCalls = m_diffCounters.getCtr(DxvkStatCounter::CmdRenderPassCount) / frameCount;
+    const uint64_t rpClears = m_diffCounters.getCtr(DxvkStatCounter::CmdClearsElided)   / frameCount;
     
     const std::string strDrawCalls      = str::format("Draw calls:     ", gpCalls);
     const std::string strDispatchCalls  = str::format("Dispatch calls: ", cpCalls);
     const std::string strRenderPasses   = str::format("Render passes:  ", rpCalls);
+    const std::string strClearsElided   = str::format("Clears elided:  ", rpClears);
     
     renderer.drawText(context, 16.0f,
       { position.x, position.y },
@@ -72,7 +92,12 @@ namespace dxvk::hud {
       { 1.0f, 1.0f, 1.0f, 1.0f },
       strRenderPasses);
     
-    return { position.x, position.y + 64 };
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 60.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strClearsElided);
+    
+    return { position.x, position.y + 84 };
   }
   
   
@@ -82,15 +107,43 @@ namespace dxvk::hud {
           HudPos            position) {
     const uint64_t frameCount = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1);
     const uint64_t numSubmits = m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitCount) / frameCount;
+    const uint64_t numCmdLists = m_diffCounters.getCtr(DxvkStatCounter::QueueCmdListCount) / frameCount;
+    
+    const uint64_t totalSubmits = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitCount), 1);
+    const uint64_t submitTime   = m_diffCounters.getCtr(DxvkStatCounter::QueueSubmitTime) / totalSubmits;
+    
+    const uint64_t totalRetired = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueueRetireCount), 1);
+    const uint64_t signalTime   = m_diffCounters.getCtr(DxvkStatCounter::QueueSignalTime) / totalRetired;
+    const uint64_t retireTime   = m_diffCounters.getCtr(DxvkStatCounter::QueueRetireTime) / totalRetired;
+    
+    const std::string strSubmissions = str::format("Queue submissions: ", numSubmits, " (", numCmdLists, " lists)");
+    const std::string strSubmitTime  = str::format("Submit time:       ", submitTime, " us");
+    const std::string strRetireTime  = str::format("Signal / retire:   ", signalTime, " / ", retireTime, " us");
     
-    const std::string strSubmissions = str::format("Queue submissions: ", numSubmits);
+    const uint64_t numTracked = m_diffCounters.getCtr(DxvkStatCounter::CmdTrackedResources) / frameCount;
+    const std::string strTracked     = str::format("Tracked resources: ", numTracked);
     
     renderer.drawText(context, 16.0f,
       { position.x, position.y },
       { 1.0f, 1.0f, 1.0f, 1.0f },
       strSubmissions);
     
-    return { position.x, position.y + 24.0f };
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 20.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strSubmitTime);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 40.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strRetireTime);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 60.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strTracked);
+    
+    return { position.x, position.y + 84.0f };
   }
   
   
@@ -126,9 +179,11 @@ namespace dxvk::hud {
     
     const uint64_t memAllocated = m_prevCounters.getCtr(DxvkStatCounter::MemoryAllocated);
     const uint64_t memUsed      = m_prevCounters.getCtr(DxvkStatCounter::MemoryUsed);
+    const uint64_t memSpare     = m_prevCounters.getCtr(DxvkStatCounter::MemorySpare);
     
     const std::string strMemAllocated = str::format("Memory allocated: ", memAllocated / mib, " MB");
     const std::string strMemUsed      = str::format("Memory used:      ", memUsed      / mib, " MB");
+    const std::string strMemSpare     = str::format("Spare slices:     ", memSpare     / mib, " MB");
     
     renderer.drawText(context, 16.0f,
       { position.x, position.y },
@@ -140,16 +195,111 @@ namespace dxvk::hud {
       { 1.0f, 1.0f, 1.0f, 1.0f },
       strMemUsed);
     
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 40.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strMemSpare);
+    
+    return { position.x, position.y + 64.0f };
+  }
+  
+  
+  HudPos HudStats::printCsThreadStats(
+    const Rc<DxvkContext>&  context,
+          HudRenderer&      renderer,
+          HudPos            position) {
+    const uint64_t frameCount = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1);
+    
+    const uint64_t busyTime = m_diffCounters.getCtr(DxvkStatCounter::CsBusyTime);
+    const uint64_t busyPct  = std::min<uint64_t>(100, (100 * busyTime) / std::max<uint64_t>(m_diffTimeUs, 1));
+    
+    const uint64_t syncTime = m_diffCounters.getCtr(DxvkStatCounter::CsSyncTime)  / frameCount;
+    const uint64_t waitTime = m_diffCounters.getCtr(DxvkStatCounter::GpuSyncTime) / frameCount;
+    
+    const std::string strBusy = str::format("CS thread busy:  ", busyPct, "%");
+    const std::string strSync = str::format("CS sync / wait:  ", syncTime, " / ", waitTime, " us");
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strBusy);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y + 20.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strSync);
+    
     return { position.x, position.y + 44.0f };
   }
   
   
+  HudPos HudStats::printCompileStats(
+    const Rc<DxvkContext>&  context,
+          HudRenderer&      renderer,
+          HudPos            position) {
+    const uint64_t compileCount = m_diffCounters.getCtr(DxvkStatCounter::PipeCompileCount);
+    const uint64_t compileTime  = m_diffCounters.getCtr(DxvkStatCounter::PipeCompileTime);
+    
+    // Highlight frames that stalled on pipeline compilation
+    const std::string strCompiles = str::format("Pipeline compiles: ", compileCount, " (", compileTime / 1000, " ms)");
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      compileCount != 0
+        ? HudColor { 1.0f, 0.5f, 0.5f, 1.0f }
+        : HudColor { 1.0f, 1.0f, 1.0f, 1.0f },
+      strCompiles);
+    
+    return { position.x, position.y + 24.0f };
+  }
+  
+  
+  HudPos HudStats::printBarrierStats(
+    const Rc<DxvkContext>&  context,
+          HudRenderer&      renderer,
+          HudPos            position) {
+    const uint64_t frameCount = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1);
+    const uint64_t barriers   = m_diffCounters.getCtr(DxvkStatCounter::CmdBarrierCount) / frameCount;
+    
+    const std::string strBarriers = str::format("Barriers:        ", barriers);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strBarriers);
+    
+    return { position.x, position.y + 24.0f };
+  }
+  
+  
+  HudPos HudStats::printDescriptorStats(
+    const Rc<DxvkContext>&  context,
+          HudRenderer&      renderer,
+          HudPos            position) {
+    const uint64_t frameCount = std::max<uint64_t>(m_diffCounters.getCtr(DxvkStatCounter::QueuePresentCount), 1);
+    const uint64_t descSets   = m_diffCounters.getCtr(DxvkStatCounter::CmdDescriptorSetCount) / frameCount;
+    
+    const std::string strDescSets = str::format("Descriptor sets: ", descSets);
+    
+    renderer.drawText(context, 16.0f,
+      { position.x, position.y },
+      { 1.0f, 1.0f, 1.0f, 1.0f },
+      strDescSets);
+    
+    return { position.x, position.y + 24.0f };
+  }
+  
+  
   HudElements HudStats::filterElements(HudElements elements) {
     return elements & HudElements(
       HudElement::StatDrawCalls,
       HudElement::StatSubmissions,
       HudElement::StatPipelines,
-      HudElement::StatMemory);
+      HudElement::StatMemory,
+      HudElement::StatCsThread,
+      HudElement::StatCompiles,
+      HudElement::StatBarriers,
+      HudElement::StatDescriptors);
   }
   
 }
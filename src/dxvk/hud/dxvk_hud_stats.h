@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "../dxvk_stats.h"
 
 #include "dxvk_hud_config.h"
@@ -36,6 +38,9 @@ namespace dxvk::hud {
     DxvkStatCounters  m_prevCounters;
     DxvkStatCounters  m_diffCounters;
     
+    std::chrono::high_resolution_clock::time_point m_prevUpdate;
+    uint64_t          m_diffTimeUs = 0;
+    
     HudPos printDrawCallStats(
       const Rc<DxvkContext>&  context,
             HudRenderer&      renderer,
@@ -56,6 +61,26 @@ namespace dxvk::hud {
             HudRenderer&      renderer,
             HudPos            position);
     
+    HudPos printCsThreadStats(
+      const Rc<DxvkContext>&  context,
+            HudRenderer&      renderer,
+            HudPos            position);
+    
+    HudPos printCompileStats(
+      const Rc<DxvkContext>&  context,
+            HudRenderer&      renderer,
+            HudPos            position);
+    
+    HudPos printBarrierStats(
+      const Rc<DxvkContext>&  context,
+            HudRenderer&      renderer,
+            HudPos            position);
+    
+    HudPos printDescriptorStats(
+      const Rc<DxvkContext>&  context,
+            HudRenderer&      renderer,
+            HudPos            position);
+    
     static HudElements filterElements(HudElements elements);
     
   };
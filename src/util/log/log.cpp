@@ -1,17 +1,205 @@
+#include <atomic>
+#include <condition_variable>
+
 #include "log.h"
 
+#include "../thread.h"
 #include "../util_env.h"
 
 namespace dxvk {
   
+  /**
+   * \brief Log writer
+   * 
+   * Stores messages in a bounded lock-free queue that
+   * is drained by a background thread. If the queue
+   * is full, messages get dropped rather than stalling
+   * the calling thread, and a warning is written once
+   * the writer catches up. Errors are written out
+   * synchronously, along with any queued messages, so
+   * that they do not get lost if the process crashes.
+   * 
+   * The writer thread is started on the first message
+   * and runs until the process exits. The writer object
+   * itself is intentionally never freed, since the thread
+   * may still be running when the logger gets destroyed.
+   */
+  class LogWriter {
+    constexpr static uint64_t QueueSize = 1024;
+  public:
+    
+    LogWriter(const std::string& fileName)
+    : m_fileStream(fileName) {
+      for (uint64_t i = 0; i < QueueSize; i++)
+        m_entries[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    void push(LogLevel level, const std::string& message) {
+      std::call_once(m_threadInit, [this] {
+        // Pin the module so that it cannot be unloaded while
+        // the thread is running, since the thread never exits
+        HMODULE module = nullptr;
+        
+        ::GetModuleHandleExW(
+          GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+          GET_MODULE_HANDLE_EX_FLAG_PIN,
+          reinterpret_cast<LPCWSTR>(&Logger::info),
+          &module);
+        
+        m_thread = dxvk::thread([this] { this->run(); });
+      });
+      
+      if (level >= LogLevel::Error) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        
+        std::string lines = this->readEntries();
+        lines += formatLine(level, message);
+        
+        this->writeLines(lines);
+        return;
+      }
+      
+      // Multi-producer enqueue, see Dmitry Vyukov's bounded queue
+      uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+      
+      while (true) {
+        Entry& entry = m_entries[index % QueueSize];
+        
+        uint64_t sequence = entry.sequence.load(std::memory_order_acquire);
+        int64_t  delta    = int64_t(sequence - index);
+        
+        if (delta == 0) {
+          if (m_writeIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+            entry.level   = level;
+            entry.message = message;
+            entry.sequence.store(index + 1, std::memory_order_release);
+            break;
+          }
+        } else if (delta < 0) {
+          m_dropCount += 1;
+          return;
+        } else {
+          index = m_writeIndex.load(std::memory_order_relaxed);
+        }
+      }
+      
+      // Acquiring the lock orders the enqueue with the writer
+      // thread's wait predicate, so the wakeup cannot be lost
+      { std::lock_guard<std::mutex> lock(m_waitMutex); }
+      
+      m_cond.notify_one();
+    }
+    
+    void flush() {
+      // On process exit, the writer thread may have been
+      // terminated while holding the lock, so don't block
+      std::unique_lock<std::mutex> lock(m_writeMutex, std::try_to_lock);
+      
+      if (lock)
+        this->writeLines(this->readEntries());
+    }
+    
+  private:
+    
+    struct Entry {
+      std::atomic<uint64_t> sequence;
+      LogLevel              level;
+      std::string           message;
+    };
+    
+    std::array<Entry, QueueSize> m_entries;
+    
+    std::atomic<uint64_t> m_writeIndex = { 0ull };
+    std::atomic<uint64_t> m_readIndex  = { 0ull };
+    std::atomic<uint32_t> m_dropCount  = { 0u };
+    
+    std::mutex              m_waitMutex;
+    std::mutex              m_writeMutex;
+    std::condition_variable m_cond;
+    std::once_flag          m_threadInit;
+    std::ofstream           m_fileStream;
+    dxvk::thread            m_thread;
+    
+    bool hasEntries() const {
+      uint64_t index = m_readIndex.load(std::memory_order_relaxed);
+      
+      const Entry& entry = m_entries[index % QueueSize];
+      return entry.sequence.load(std::memory_order_acquire) == index + 1;
+    }
+    
+    void run() {
+      env::setThreadName("dxvk-log");
+      
+      while (true) {
+        { std::unique_lock<std::mutex> lock(m_waitMutex);
+          
+          m_cond.wait(lock, [this] {
+            return this->hasEntries() || m_dropCount.load();
+          });
+        }
+        
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        this->writeLines(this->readEntries());
+      }
+    }
+    
+    std::string readEntries() {
+      std::string lines;
+      
+      while (this->hasEntries()) {
+        uint64_t index = m_readIndex.load(std::memory_order_relaxed);
+        Entry& entry = m_entries[index % QueueSize];
+        
+        lines += formatLine(entry.level, entry.message);
+        
+        entry.message.clear();
+        entry.sequence.store(index + QueueSize, std::memory_order_release);
+        m_readIndex.store(index + 1, std::memory_order_relaxed);
+      }
+      
+      uint32_t dropCount = m_dropCount.exchange(0);
+      
+      if (dropCount) {
+        lines += formatLine(LogLevel::Warn,
+          str::format("Logger: Dropped ", dropCount, " messages"));
+      }
+      
+      return lines;
+    }
+    
+    void writeLines(const std::string& lines) {
+      if (!lines.empty()) {
+        std::cerr    << lines << std::flush;
+        m_fileStream << lines << std::flush;
+      }
+    }
+    
+    static std::string formatLine(LogLevel level, const std::string& message) {
+      static std::array<const char*, 5> s_prefixes
+        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
+      
+      std::string line = s_prefixes.at(static_cast<uint32_t>(level));
+      line += message;
+      line += '\n';
+      return line;
+    }
+    
+  };
+  
+  
   Logger::Logger(const std::string& file_name)
   : m_minLevel(getMinLogLevel()) {
     if (m_minLevel != LogLevel::None)
-      m_fileStream = std::ofstream(getFileName(file_name));
+      m_writer = new LogWriter(getFileName(file_name));
   }
   
   
-  Logger::~Logger() { }
+  Logger::~Logger() {
+    // The writer thread is either already terminated or still
+    // running at this point, so just write out what's left
+    if (m_writer != nullptr)
+      m_writer->flush();
+  }
   
   
   void Logger::trace(const std::string& message) {
@@ -45,16 +233,8 @@ namespace dxvk {
   
   
   void Logger::emitMsg(LogLevel level, const std::string& message) {
-    if (level >= m_minLevel) {
-      std::lock_guard<std::mutex> lock(m_mutex);
-      
-      static std::array<const char*, 5> s_prefixes
-        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
-      
-      const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
-      std::cerr    << prefix << message << std::endl;
-      m_fileStream << prefix << message << std::endl;
-    }
+    if (level >= m_minLevel)
+      m_writer->push(level, message);
   }
   
   
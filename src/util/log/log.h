@@ -6,6 +6,8 @@
 #include <mutex>
 #include <string>
 
+#include "../util_string.h"
+
 namespace dxvk {
   
   enum class LogLevel : uint32_t {
@@ -17,11 +19,17 @@ namespace dxvk {
     None  = 5,
   };
   
+  class LogWriter;
+  
   /**
    * \brief Logger
    * 
    * Logger for one DLL. Creates a text file and
-   * writes all log messages to that file.
+   * writes all log messages to that file. Messages
+   * are written by a background thread, so that
+   * logging does not block the calling thread on
+   * file or console I/O. Errors are written out
+   * immediately.
    */
   class Logger {
     
@@ -37,6 +45,21 @@ namespace dxvk {
     static void err  (const std::string& message);
     static void log  (LogLevel level, const std::string& message);
     
+    /**
+     * \brief Logs a message with deferred formatting
+     * 
+     * Arguments are only passed to \c str::format if
+     * messages of the given log level are enabled, so
+     * this should be used for frequent debug messages.
+     * \param [in] level Log level
+     * \param [in] args Message parts
+     */
+    template<typename... Args>
+    static void log(LogLevel level, const Args&... args) {
+      if (level >= s_instance.m_minLevel)
+        s_instance.emitMsg(level, str::format(args...));
+    }
+    
     static LogLevel logLevel() {
       return s_instance.m_minLevel;
     }
@@ -47,8 +70,7 @@ namespace dxvk {
     
     const LogLevel m_minLevel;
     
-    std::mutex    m_mutex;
-    std::ofstream m_fileStream;
+    LogWriter* m_writer = nullptr;
     
     void emitMsg(LogLevel level, const std::string& message);
     
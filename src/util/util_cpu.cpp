@@ -0,0 +1,76 @@
+#include "util_cpu.h"
+
+#ifdef DXVK_ARCH_X86
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+namespace dxvk::cpu {
+  
+#ifdef DXVK_ARCH_X86
+  static void queryCpuid(uint32_t leaf, uint32_t subleaf, uint32_t* regs) {
+    #ifdef _MSC_VER
+    int data[4];
+    __cpuidex(data, int(leaf), int(subleaf));
+    
+    for (uint32_t i = 0; i < 4; i++)
+      regs[i] = uint32_t(data[i]);
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+  }
+  
+  
+  static uint64_t queryXcr0() {
+    #ifdef _MSC_VER
+    return _xgetbv(0);
+    #else
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+    return uint64_t(lo) | (uint64_t(hi) << 32);
+    #endif
+  }
+#endif
+  
+  
+  static Features detectFeatures() {
+    Features features;
+    
+#ifdef DXVK_ARCH_X86
+    uint32_t regs[4];
+    queryCpuid(0, 0, regs);
+    
+    uint32_t maxLeaf = regs[0];
+    
+    if (maxLeaf < 1)
+      return features;
+    
+    queryCpuid(1, 0, regs);
+    features.sse2 = (regs[3] & (1u << 26)) != 0;
+    
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx     = (regs[2] & (1u << 28)) != 0;
+    
+    if (maxLeaf >= 7 && osxsave && avx) {
+      // Both the XMM and YMM state must be
+      // enabled by the operating system
+      bool osAvx = (queryXcr0() & 0x6) == 0x6;
+      
+      queryCpuid(7, 0, regs);
+      features.avx2 = osAvx && (regs[1] & (1u << 5)) != 0;
+    }
+#endif
+    
+    return features;
+  }
+  
+  
+  const Features& getFeatures() {
+    static const Features s_features = detectFeatures();
+    return s_features;
+  }
+  
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define DXVK_ARCH_X86
+  
+  // Allows using intrinsics in functions that are only
+  // called after checking for support at runtime
+  #ifdef _MSC_VER
+    #define DXVK_TARGET_SSE2
+    #define DXVK_TARGET_AVX2
+  #else
+    #define DXVK_TARGET_SSE2 __attribute__((target("sse2")))
+    #define DXVK_TARGET_AVX2 __attribute__((target("avx2")))
+  #endif
+#endif
+
+namespace dxvk::cpu {
+  
+  /**
+   * \brief CPU features
+   * 
+   * Instruction set extensions that are
+   * used by optimized code paths.
+   */
+  struct Features {
+    bool sse2 = false;
+    bool avx2 = false;
+  };
+  
+  /**
+   * \brief Queries CPU features
+   * 
+   * Features are detected once and cached. AVX2 is only
+   * reported if the operating system also saves the YMM
+   * registers on context switches.
+   * \returns Supported CPU features
+   */
+  const Features& getFeatures();
+  
+}
@@ -1,4 +1,5 @@
 #include "util_env.h"
+#include "util_trace.h"
 
 #include "./com/com_include.h"
 
@@ -29,6 +30,8 @@ namespace dxvk::env {
   
   
   void setThreadName(const std::string& name) {
+    Tracer::nameThread(name);
+    
     using SetThreadDescriptionProc = void (WINAPI *) (HANDLE, PCWSTR);
 
     HMODULE module = ::GetModuleHandleW(L"kernel32.dll");
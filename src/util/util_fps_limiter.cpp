@@ -0,0 +1,104 @@
+#include <algorithm>
+
+#include "thread.h"
+#include "util_fps_limiter.h"
+
+namespace dxvk {
+
+  FpsLimiter::FpsLimiter() {
+
+  }
+
+
+  FpsLimiter::~FpsLimiter() {
+
+  }
+
+
+  void FpsLimiter::setTargetFrameRate(double frameRate) {
+    m_targetInterval = frameRate > 0.0
+      ? TimeDiff(int64_t(1'000'000.0 / frameRate))
+      : TimeDiff(0);
+
+    m_initialized = false;
+  }
+
+
+  uint32_t FpsLimiter::frameLatency(
+          TimeDiff          gpuLatency,
+          uint32_t          maxLatency) const {
+    if (!isEnabled())
+      return maxLatency;
+
+    // One frame for the one currently being recorded,
+    // plus enough frames to keep the GPU busy
+    uint32_t latency = 1 + uint32_t(
+      (gpuLatency.count() + m_targetInterval.count() - 1)
+      / m_targetInterval.count());
+
+    return std::min(std::max(latency, 1u), maxLatency);
+  }
+
+
+  void FpsLimiter::delay() {
+    if (!isEnabled())
+      return;
+
+    TimePoint now = Clock::now();
+
+    if (!m_initialized) {
+      m_nextFrame   = now + m_targetInterval;
+      m_lastFrame   = now;
+      m_initialized = true;
+      return;
+    }
+
+    if (now < m_nextFrame) {
+      this->sleepUntil(m_nextFrame);
+      now = Clock::now();
+    }
+
+    // Measure against the previous frame rather than the
+    // deadline, which we never return before, so that
+    // frames released early to catch up show up as well
+    m_pacingError = std::chrono::duration_cast<TimeDiff>(now - m_lastFrame) - m_targetInterval;
+    m_lastFrame   = now;
+
+    // If we missed the deadline by more than a full frame,
+    // start over from the current time rather than trying
+    // to catch up by issuing a burst of frames.
+    if (now - m_nextFrame > m_targetInterval)
+      m_nextFrame = now + m_targetInterval;
+    else
+      m_nextFrame += m_targetInterval;
+  }
+
+
+  void FpsLimiter::sleepUntil(TimePoint t) {
+    TimePoint now = Clock::now();
+
+    // Sleep in small steps while we are far enough away from
+    // the deadline, and adjust the threshold based on how much
+    // the system overshoots the requested sleep duration.
+    while (t - now > m_sleepThreshold) {
+      TimeDiff sleepTime = std::chrono::duration_cast<TimeDiff>(
+        t - now - m_sleepThreshold);
+
+      ::Sleep(std::max<DWORD>(DWORD(sleepTime.count() / 1000), 1));
+
+      TimePoint then = Clock::now();
+      TimeDiff  slept = std::chrono::duration_cast<TimeDiff>(then - now);
+      TimeDiff  overshoot = slept - std::max(sleepTime, TimeDiff(1000));
+
+      m_sleepThreshold = std::max(TimeDiff(500), std::min(TimeDiff(4000),
+        (m_sleepThreshold * 7 + overshoot + TimeDiff(1000)) / 8));
+
+      now = then;
+    }
+
+    // Spin for the remaining time
+    while (Clock::now() < t)
+      dxvk::this_thread::yield();
+  }
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace dxvk {
+
+  /**
+   * \brief Frame rate limiter
+   *
+   * Delays the calling thread so that frames are
+   * issued at a fixed rate. In order to keep jitter
+   * low, the limiter sleeps for most of the remaining
+   * frame time and busy-waits for the rest, where the
+   * spin threshold is derived from the measured sleep
+   * accuracy of the system.
+   */
+  class FpsLimiter {
+    using Clock     = std::chrono::high_resolution_clock;
+    using TimeDiff  = std::chrono::microseconds;
+    using TimePoint = typename Clock::time_point;
+  public:
+
+    FpsLimiter();
+    ~FpsLimiter();
+
+    /**
+     * \brief Sets target frame rate
+     *
+     * \param [in] frameRate Target frame rate, or
+     *    a value of zero to disable the limiter.
+     */
+    void setTargetFrameRate(double frameRate);
+
+    /**
+     * \brief Checks whether the limiter is enabled
+     * \returns \c true if a target frame rate is set
+     */
+    bool isEnabled() const {
+      return m_targetInterval.count() != 0;
+    }
+
+    /**
+     * \brief Target frame interval
+     * \returns Target frame time, in microseconds
+     */
+    TimeDiff targetInterval() const {
+      return m_targetInterval;
+    }
+
+    /**
+     * \brief Pacing error of the last frame
+     *
+     * Difference between the time between the last two
+     * calls to \ref delay and the target frame time.
+     * Positive values indicate that the frame was late,
+     * negative values that the limiter released it early
+     * in order to catch up after a late frame.
+     * \returns Pacing error, in microseconds
+     */
+    TimeDiff pacingError() const {
+      return m_pacingError;
+    }
+
+    /**
+     * \brief Computes frame latency for the GPU
+     *
+     * When frames are paced, there is no benefit in
+     * letting the CPU run further ahead of the GPU than
+     * necessary to keep it busy. Returns the number of
+     * frames needed to cover the measured time it takes
+     * for a submission to complete on the GPU.
+     * \param [in] gpuLatency Measured submission latency
+     * \param [in] maxLatency Maximum frame latency
+     * \returns Frame latency to use for the next frame
+     */
+    uint32_t frameLatency(
+            TimeDiff          gpuLatency,
+            uint32_t          maxLatency) const;
+
+    /**
+     * \brief Waits for the next frame
+     *
+     * Blocks the calling thread until the target time
+     * of the next frame is reached. Should be called
+     * exactly once per frame. Does nothing if the
+     * limiter is disabled.
+     */
+    void delay();
+
+  private:
+
+    TimeDiff  m_targetInterval  = TimeDiff(0);
+    TimeDiff  m_pacingError     = TimeDiff(0);
+    TimeDiff  m_sleepThreshold  = TimeDiff(2000);
+
+    TimePoint m_nextFrame;
+    TimePoint m_lastFrame;
+    bool      m_initialized     = false;
+
+    void sleepUntil(TimePoint t);
+
+  };
+
+}
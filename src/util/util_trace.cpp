@@ -0,0 +1,223 @@
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "thread.h"
+#include "util_env.h"
+#include "util_trace.h"
+
+#include "./sync/sync_spinlock.h"
+
+namespace dxvk {
+
+  /**
+   * \brief Trace event
+   */
+  struct TraceEvent {
+    const char*       name;
+    uint32_t          pid;
+    uint32_t          tid;
+    Tracer::TimePoint start;
+    Tracer::TimePoint end;
+  };
+
+
+  /**
+   * \brief Trace writer
+   *
+   * Collects events and writes them to the trace file on
+   * a background thread. Like the log writer, this object
+   * is never freed and its module gets pinned, since the
+   * writer thread does not exit until the process does.
+   */
+  class TraceWriter {
+    constexpr static size_t   BatchSize = 4096;
+    constexpr static uint32_t CpuPid    = 1;
+    constexpr static uint32_t GpuPid    = 2;
+  public:
+
+    TraceWriter(const std::string& fileName)
+    : m_fileStream(fileName, std::ios::trunc),
+      m_epoch(Tracer::Clock::now()) {
+      // Use the JSON array format, which does not require a
+      // closing bracket, so that traces survive a crash
+      m_fileStream << "[" << std::endl;
+      m_fileStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << CpuPid
+                   << ",\"args\":{\"name\":\"" << env::getExeName() << "\"}}," << std::endl;
+      m_fileStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << GpuPid
+                   << ",\"args\":{\"name\":\"GPU\"}}," << std::endl;
+
+      HMODULE module = nullptr;
+
+      ::GetModuleHandleExW(
+        GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+        GET_MODULE_HANDLE_EX_FLAG_PIN,
+        reinterpret_cast<LPCWSTR>(&Tracer::nameThread),
+        &module);
+
+      m_thread = dxvk::thread([this] { this->run(); });
+    }
+
+    void addEvent(
+      const char*               name,
+            uint32_t            pid,
+            Tracer::TimePoint   start,
+            Tracer::TimePoint   end) {
+      uint32_t tid = pid == GpuPid ? 0 : ::GetCurrentThreadId();
+
+      std::lock_guard<sync::Spinlock> lock(m_eventLock);
+      m_events.push_back({ name, pid, tid, start, end });
+
+      if (m_events.size() == BatchSize)
+        m_cond.notify_one();
+    }
+
+    void addCpuEvent(const char* name, Tracer::TimePoint start, Tracer::TimePoint end) {
+      this->addEvent(name, CpuPid, start, end);
+    }
+
+    void addGpuEvent(const char* name, Tracer::TimePoint start, Tracer::TimePoint end) {
+      this->addEvent(name, GpuPid, start, end);
+    }
+
+    void addThreadName(const std::string& name) {
+      std::lock_guard<sync::Spinlock> lock(m_eventLock);
+      m_threadNames.push_back(str::format(
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":", CpuPid,
+        ",\"tid\":", ::GetCurrentThreadId(),
+        ",\"args\":{\"name\":\"", name, "\"}},\n"));
+    }
+
+    void flush() {
+      std::unique_lock<std::mutex> lock(m_fileMutex, std::try_to_lock);
+
+      if (lock)
+        this->writeEvents();
+    }
+
+  private:
+
+    std::ofstream           m_fileStream;
+    Tracer::TimePoint       m_epoch;
+
+    sync::Spinlock          m_eventLock;
+    std::vector<TraceEvent> m_events;
+    std::vector<std::string> m_threadNames;
+
+    std::mutex              m_fileMutex;
+    std::condition_variable m_cond;
+    dxvk::thread            m_thread;
+
+    void run() {
+      env::setThreadName("dxvk-trace");
+
+      std::unique_lock<std::mutex> lock(m_fileMutex);
+
+      while (true) {
+        // Write events at least once a second even if the
+        // batch is not full, so that the trace file does
+        // not lag too far behind if the process hangs
+        m_cond.wait_for(lock, std::chrono::seconds(1));
+        this->writeEvents();
+      }
+    }
+
+    void writeEvents() {
+      std::vector<TraceEvent>  events;
+      std::vector<std::string> threadNames;
+      events.reserve(BatchSize);
+
+      { std::lock_guard<sync::Spinlock> lock(m_eventLock);
+        std::swap(events, m_events);
+        std::swap(threadNames, m_threadNames);
+      }
+
+      for (const auto& threadName : threadNames)
+        m_fileStream << threadName;
+
+      for (const auto& e : events) {
+        m_fileStream << "{\"name\":\"" << e.name
+                     << "\",\"ph\":\"X\",\"pid\":" << e.pid
+                     << ",\"tid\":" << e.tid
+                     << ",\"ts\":" << this->toUs(e.start)
+                     << ",\"dur\":" << this->toUs(e.end) - this->toUs(e.start)
+                     << "}," << '\n';
+      }
+
+      m_fileStream.flush();
+    }
+
+    double toUs(Tracer::TimePoint t) const {
+      return double(std::chrono::duration_cast<std::chrono::nanoseconds>(t - m_epoch).count()) / 1000.0;
+    }
+
+  };
+
+
+  Tracer::Tracer() {
+    std::string path = env::getEnvVar("DXVK_TRACE_PATH");
+
+    if (path.empty())
+      return;
+
+    if (*path.rbegin() != '/')
+      path += '/';
+
+    // Every DLL has its own tracer instance, so
+    // include the module name in the file name
+    HMODULE module = nullptr;
+
+    ::GetModuleHandleExW(
+      GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+      GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+      reinterpret_cast<LPCWSTR>(&Tracer::nameThread),
+      &module);
+
+    std::vector<WCHAR> modulePath(MAX_PATH + 1);
+    DWORD len = ::GetModuleFileNameW(module, modulePath.data(), MAX_PATH);
+    modulePath.resize(len + 1);
+
+    std::string moduleName = str::fromws(modulePath.data());
+    std::string exeName    = env::getExeName();
+
+    moduleName = moduleName.substr(moduleName.find_last_of('\\') + 1);
+    moduleName = moduleName.substr(0, moduleName.find_last_of('.'));
+    exeName    = exeName.substr(0, exeName.find_last_of('.'));
+
+    m_writer = new TraceWriter(str::format(path, exeName, "_", moduleName, ".trace.json"));
+  }
+
+
+  Tracer::~Tracer() {
+    if (m_writer != nullptr)
+      m_writer->flush();
+  }
+
+
+  void Tracer::recordCpuZone(
+    const char*               name,
+          TimePoint           start,
+          TimePoint           end) {
+    s_instance.m_writer->addCpuEvent(name, start, end);
+  }
+
+
+  void Tracer::recordGpuZone(
+    const char*               name,
+          TimePoint           start,
+          TimePoint           end) {
+    s_instance.m_writer->addGpuEvent(name, start, end);
+  }
+
+
+  void Tracer::nameThread(
+    const std::string&        name) {
+    if (isEnabled())
+      s_instance.m_writer->addThreadName(name);
+  }
+
+
+  Tracer Tracer::s_instance;
+
+}
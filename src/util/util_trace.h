@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace dxvk {
+
+  class TraceWriter;
+
+  /**
+   * \brief Timeline tracer
+   *
+   * Records CPU and GPU zones and writes them to a file
+   * in the Chrome trace event format, which can be loaded
+   * in \c chrome://tracing or Perfetto. Tracing is enabled
+   * by setting \c DXVK_TRACE_PATH to an existing directory.
+   * When disabled, zones only cost a predictable branch.
+   */
+  class Tracer {
+
+  public:
+
+    using Clock     = std::chrono::high_resolution_clock;
+    using TimePoint = typename Clock::time_point;
+
+    Tracer();
+    ~Tracer();
+
+    /**
+     * \brief Checks whether tracing is enabled
+     * \returns \c true if zones are recorded
+     */
+    static bool isEnabled() {
+      return s_instance.m_writer != nullptr;
+    }
+
+    /**
+     * \brief Records a CPU zone
+     *
+     * The zone is assigned to the calling thread.
+     * \param [in] name Zone name, must be a literal
+     * \param [in] start Start time of the zone
+     * \param [in] end End time of the zone
+     */
+    static void recordCpuZone(
+      const char*               name,
+            TimePoint           start,
+            TimePoint           end);
+
+    /**
+     * \brief Records a GPU zone
+     *
+     * GPU zones are shown in a separate process on
+     * the timeline. Time stamps must already be
+     * converted to the CPU time domain.
+     * \param [in] name Zone name, must be a literal
+     * \param [in] start Start time of the zone
+     * \param [in] end End time of the zone
+     */
+    static void recordGpuZone(
+      const char*               name,
+            TimePoint           start,
+            TimePoint           end);
+
+    /**
+     * \brief Sets name of the calling thread
+     *
+     * Only affects how the thread is labeled
+     * on the timeline.
+     * \param [in] name Thread name
+     */
+    static void nameThread(
+      const std::string&        name);
+
+  private:
+
+    static Tracer s_instance;
+
+    TraceWriter* m_writer = nullptr;
+
+  };
+
+
+  /**
+   * \brief Scoped CPU zone
+   *
+   * Records a CPU zone that covers the lifetime
+   * of the object if tracing is enabled.
+   */
+  class TraceZone {
+
+  public:
+
+    TraceZone(const char* name) {
+      if (Tracer::isEnabled()) {
+        m_name  = name;
+        m_start = Tracer::Clock::now();
+      }
+    }
+
+    ~TraceZone() {
+      if (m_name != nullptr)
+        Tracer::recordCpuZone(m_name, m_start, Tracer::Clock::now());
+    }
+
+    TraceZone             (const TraceZone&) = delete;
+    TraceZone& operator = (const TraceZone&) = delete;
+
+  private:
+
+    const char*       m_name = nullptr;
+    Tracer::TimePoint m_start;
+
+  };
+
+}
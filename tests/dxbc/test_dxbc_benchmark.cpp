@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+
+#include "../../src/dxbc/dxbc_module.h"
+#include "../../src/dxvk/dxvk_shader.h"
+
+#include "../../src/util/thread.h"
+
+#include <shellapi.h>
+#include <windows.h>
+#include <windowsx.h>
+#include <psapi.h>
+
+namespace dxvk {
+  Logger Logger::s_instance("dxbc-benchmark.log");
+}
+
+using namespace dxvk;
+
+using Clock    = std::chrono::high_resolution_clock;
+using TimeDiff = std::chrono::microseconds;
+
+/**
+ * \brief Benchmark result for one shader
+ */
+struct ShaderResult {
+  std::string fileName;
+  bool        success       = false;
+  std::string error;
+  uint64_t    dxbcBytes     = 0;
+  uint64_t    spirvWords    = 0;
+  TimeDiff    parseTime     = TimeDiff(0);
+  TimeDiff    compileTime   = TimeDiff(0);
+};
+
+
+/**
+ * \brief Benchmark options
+ */
+struct BenchmarkOptions {
+  std::string directory;
+  std::string jsonFile;
+  uint32_t    threadCount = 1;
+  uint32_t    iterations  = 1;
+  bool        verbose     = false;
+};
+
+
+std::vector<std::string> findShaderFiles(const std::string& directory) {
+  std::vector<std::string> result;
+
+  WIN32_FIND_DATAW findData;
+  HANDLE handle = ::FindFirstFileW(
+    str::tows(str::format(directory, "\\*.dxbc")).data(),
+    &findData);
+
+  if (handle == INVALID_HANDLE_VALUE)
+    return result;
+
+  do {
+    if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+      result.push_back(str::format(directory, "\\", str::fromws(findData.cFileName)));
+  } while (::FindNextFileW(handle, &findData));
+
+  ::FindClose(handle);
+
+  // Keep the output order stable between runs
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+
+std::vector<char> readFile(const std::string& fileName) {
+  std::ifstream ifile(fileName, std::ios::binary);
+
+  if (!ifile)
+    throw DxvkError(str::format("Failed to open ", fileName));
+
+  return std::vector<char>(
+    std::istreambuf_iterator<char>(ifile),
+    std::istreambuf_iterator<char>());
+}
+
+
+ShaderResult compileShader(
+  const std::string&      fileName,
+  const std::vector<char>& dxbcCode,
+        uint32_t          iterations) {
+  ShaderResult result;
+  result.fileName  = fileName;
+  result.dxbcBytes = dxbcCode.size();
+
+  DxbcModuleInfo moduleInfo;
+  moduleInfo.options.useSubgroupOpsForEarlyDiscard = true;
+  moduleInfo.options.useRawSsbo = true;
+  moduleInfo.tess = nullptr;
+  moduleInfo.xfb  = nullptr;
+
+  try {
+    for (uint32_t i = 0; i < iterations; i++) {
+      auto t0 = Clock::now();
+
+      DxbcReader reader(dxbcCode.data(), dxbcCode.size());
+      DxbcModule module(reader);
+
+      auto t1 = Clock::now();
+
+      Rc<DxvkShader> shader = module.compile(moduleInfo, fileName);
+
+      auto t2 = Clock::now();
+
+      result.parseTime   += std::chrono::duration_cast<TimeDiff>(t1 - t0);
+      result.compileTime += std::chrono::duration_cast<TimeDiff>(t2 - t1);
+
+      if (i == 0) {
+        std::ostringstream stream;
+        shader->dump(stream);
+        result.spirvWords = stream.str().size() / sizeof(uint32_t);
+      }
+    }
+
+    result.parseTime   /= iterations;
+    result.compileTime /= iterations;
+    result.success = true;
+  } catch (const DxvkError& e) {
+    result.error = e.message();
+  }
+
+  return result;
+}
+
+
+std::string escapeJson(const std::string& str) {
+  std::string result;
+
+  for (char c : str) {
+    if (c == '\\' || c == '"') {
+      result.push_back('\\');
+      result.push_back(c);
+    } else if (uint8_t(c) < 0x20) {
+      // JSON does not allow raw control characters
+      // in strings, so emit them as \u escapes
+      static const char* s_hex = "0123456789abcdef";
+      result += "\\u00";
+      result.push_back(s_hex[uint8_t(c) >> 4]);
+      result.push_back(s_hex[uint8_t(c) & 0xF]);
+    } else {
+      result.push_back(c);
+    }
+  }
+
+  return result;
+}
+
+
+uint32_t parseCount(const std::string& option, const std::string& value) {
+  size_t        length = 0;
+  unsigned long result = 0;
+
+  try {
+    result = std::stoul(value, &length);
+  } catch (const std::exception&) {
+    length = 0;
+  }
+
+  if (length == 0 || length != value.size() || value[0] == '-'
+   || result == 0 || result > 0xFFFFu)
+    throw DxvkError(str::format("Invalid value for ", option, ": ", value));
+
+  return uint32_t(result);
+}
+
+
+void writeJson(
+        std::ostream&               stream,
+  const BenchmarkOptions&           options,
+  const std::vector<ShaderResult>&  results,
+        TimeDiff                    wallTime,
+  const PROCESS_MEMORY_COUNTERS&    memory) {
+  uint64_t totalParse   = 0;
+  uint64_t totalCompile = 0;
+  uint64_t totalWords   = 0;
+  uint32_t failCount    = 0;
+
+  stream << "{" << std::endl
+         << "  \"threads\": " << options.threadCount << "," << std::endl
+         << "  \"iterations\": " << options.iterations << "," << std::endl
+         << "  \"shaders\": [" << std::endl;
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const ShaderResult& r = results[i];
+
+    stream << "    { \"file\": \"" << escapeJson(r.fileName) << "\""
+           << ", \"success\": " << (r.success ? "true" : "false")
+           << ", \"dxbcBytes\": " << r.dxbcBytes
+           << ", \"spirvWords\": " << r.spirvWords
+           << ", \"parseUs\": " << r.parseTime.count()
+           << ", \"compileUs\": " << r.compileTime.count();
+
+    if (!r.success)
+      stream << ", \"error\": \"" << escapeJson(r.error) << "\"";
+
+    stream << " }" << (i + 1 < results.size() ? "," : "") << std::endl;
+
+    totalParse   += r.parseTime.count();
+    totalCompile += r.compileTime.count();
+    totalWords   += r.spirvWords;
+    failCount    += r.success ? 0 : 1;
+  }
+
+  stream << "  ]," << std::endl
+         << "  \"total\": {" << std::endl
+         << "    \"shaderCount\": " << results.size() << "," << std::endl
+         << "    \"failCount\": " << failCount << "," << std::endl
+         << "    \"spirvWords\": " << totalWords << "," << std::endl
+         << "    \"parseUs\": " << totalParse << "," << std::endl
+         << "    \"compileUs\": " << totalCompile << "," << std::endl
+         << "    \"wallUs\": " << wallTime.count() << "," << std::endl
+         << "    \"peakWorkingSetBytes\": " << memory.PeakWorkingSetSize << "," << std::endl
+         << "    \"peakPagefileBytes\": " << memory.PeakPagefileUsage << std::endl
+         << "  }" << std::endl
+         << "}" << std::endl;
+}
+
+
+void writeText(
+        std::ostream&               stream,
+  const BenchmarkOptions&           options,
+  const std::vector<ShaderResult>&  results,
+        TimeDiff                    wallTime,
+  const PROCESS_MEMORY_COUNTERS&    memory) {
+  uint64_t totalParse   = 0;
+  uint64_t totalCompile = 0;
+  uint64_t totalWords   = 0;
+  uint32_t failCount    = 0;
+
+  for (const auto& r : results) {
+    if (options.verbose || !r.success) {
+      if (r.success) {
+        stream << r.fileName << ": "
+               << r.parseTime.count() << " us parse, "
+               << r.compileTime.count() << " us compile, "
+               << r.spirvWords << " words" << std::endl;
+      } else {
+        stream << r.fileName << ": FAILED: " << r.error << std::endl;
+      }
+    }
+
+    totalParse   += r.parseTime.count();
+    totalCompile += r.compileTime.count();
+    totalWords   += r.spirvWords;
+    failCount    += r.success ? 0 : 1;
+  }
+
+  stream << "Shaders:     " << results.size() << " (" << failCount << " failed)" << std::endl
+         << "Threads:     " << options.threadCount << std::endl
+         << "Parse:       " << totalParse   << " us" << std::endl
+         << "Compile:     " << totalCompile << " us" << std::endl
+         << "Wall time:   " << wallTime.count() << " us" << std::endl
+         << "SPIR-V:      " << totalWords << " words" << std::endl
+         << "Peak memory: " << (memory.PeakWorkingSetSize >> 10) << " kB working set, "
+                            << (memory.PeakPagefileUsage  >> 10) << " kB committed" << std::endl;
+}
+
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  int     argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(
+    GetCommandLineW(), &argc);
+
+  BenchmarkOptions options;
+
+  const char* usage = "Usage: dxbc-benchmark [-t threads] [-n iterations] [-j output.json] [-v] directory";
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      std::string arg = str::fromws(argv[i]);
+
+      if ((arg == "-t" || arg == "-n" || arg == "-j") && i + 1 == argc)
+        throw DxvkError(str::format("Missing value for ", arg));
+
+      if (arg == "-t")
+        options.threadCount = parseCount(arg, str::fromws(argv[++i]));
+      else if (arg == "-n")
+        options.iterations = parseCount(arg, str::fromws(argv[++i]));
+      else if (arg == "-j")
+        options.jsonFile = str::fromws(argv[++i]);
+      else if (arg == "-v")
+        options.verbose = true;
+      else if (arg.size() > 1 && arg[0] == '-')
+        throw DxvkError(str::format("Unknown option: ", arg));
+      else if (options.directory.empty())
+        options.directory = arg;
+      else
+        throw DxvkError(str::format("Unexpected argument: ", arg));
+    }
+  } catch (const DxvkError& e) {
+    std::cerr << e.message() << std::endl
+              << usage << std::endl;
+    return 1;
+  }
+
+  if (options.directory.empty()) {
+    std::cerr << usage << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> files = findShaderFiles(options.directory);
+
+  if (files.empty()) {
+    std::cerr << "No .dxbc files found in " << options.directory << std::endl;
+    return 1;
+  }
+
+  // Load all files up front so that the
+  // measurements do not include file I/O
+  std::vector<std::vector<char>> dxbcCode(files.size());
+
+  try {
+    for (size_t i = 0; i < files.size(); i++)
+      dxbcCode[i] = readFile(files[i]);
+  } catch (const DxvkError& e) {
+    std::cerr << e.message() << std::endl;
+    return 1;
+  }
+
+  std::vector<ShaderResult> results(files.size());
+  std::atomic<size_t>       nextFile = { 0u };
+
+  auto t0 = Clock::now();
+
+  std::vector<dxvk::thread> workers;
+
+  for (uint32_t i = 0; i < options.threadCount; i++) {
+    workers.emplace_back([&] {
+      size_t index;
+
+      while ((index = nextFile++) < files.size())
+        results[index] = compileShader(files[index], dxbcCode[index], options.iterations);
+    });
+  }
+
+  for (auto& worker : workers)
+    worker.join();
+
+  auto t1 = Clock::now();
+
+  TimeDiff wallTime = std::chrono::duration_cast<TimeDiff>(t1 - t0);
+
+  PROCESS_MEMORY_COUNTERS memory = { };
+  memory.cb = sizeof(memory);
+  ::K32GetProcessMemoryInfo(::GetCurrentProcess(), &memory, sizeof(memory));
+
+  writeText(std::cout, options, results, wallTime, memory);
+
+  if (!options.jsonFile.empty()) {
+    std::ofstream jsonFile(options.jsonFile, std::ios::trunc);
+    writeJson(jsonFile, options, results, wallTime, memory);
+  }
+
+  bool success = std::all_of(results.begin(), results.end(),
+    [] (const ShaderResult& r) { return r.success; });
+
+  return success ? 0 : 1;
+}
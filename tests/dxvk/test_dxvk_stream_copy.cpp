@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "../../src/dxvk/dxvk_util.h"
+
+#include <windows.h>
+
+namespace dxvk {
+  Logger Logger::s_instance("dxvk-stream-copy.log");
+}
+
+using namespace dxvk;
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr size_t MaxOffset = 64;
+constexpr size_t GuardSize = 64;
+
+/**
+ * \brief Checks one copy against memcpy
+ *
+ * Copies \c size bytes between buffers at the given
+ * offsets, and verifies that both the copied range
+ * and the guard bytes around it match the result
+ * of a plain \c memcpy.
+ */
+bool testCopy(
+        std::vector<char>&  dst,
+        std::vector<char>&  ref,
+  const std::vector<char>&  src,
+        size_t              dstOffset,
+        size_t              srcOffset,
+        size_t              size) {
+  std::memset(dst.data(), 0xCD, dstOffset + size + GuardSize);
+  std::memset(ref.data(), 0xCD, dstOffset + size + GuardSize);
+
+  util::streamCopy(&dst[dstOffset], &src[srcOffset], size);
+  util::streamFence();
+
+  std::memcpy(&ref[dstOffset], &src[srcOffset], size);
+
+  if (std::memcmp(dst.data(), ref.data(), dstOffset + size + GuardSize)) {
+    Logger::err(str::format("Mismatch: size = ", size,
+      ", dst offset = ", dstOffset, ", src offset = ", srcOffset));
+    return false;
+  }
+
+  return true;
+}
+
+
+/**
+ * \brief Measures copy throughput
+ *
+ * Copies repeatedly into the same destination, so for
+ * sizes that fit into the cache, this favours memcpy
+ * over non-temporal stores.
+ * \param [in] size Copy size, in bytes
+ * \param [in] stream Whether to use \c streamCopy
+ * \returns Throughput in MiB per second
+ */
+double timeCopy(
+        std::vector<char>&  dst,
+  const std::vector<char>&  src,
+        size_t              size,
+        bool                stream) {
+  size_t iterations = std::max<size_t>(4, (size_t(1) << 30) / size);
+
+  auto t0 = Clock::now();
+
+  for (size_t i = 0; i < iterations; i++) {
+    if (stream)
+      util::streamCopy(dst.data(), src.data(), size);
+    else
+      std::memcpy(dst.data(), src.data(), size);
+  }
+
+  if (stream)
+    util::streamFence();
+
+  auto t1 = Clock::now();
+
+  double seconds = std::chrono::duration<double>(t1 - t0).count();
+  return double(size * iterations) / (seconds * 1048576.0);
+}
+
+
+int WINAPI WinMain(HINSTANCE hInstance,
+                   HINSTANCE hPrevInstance,
+                   LPSTR lpCmdLine,
+                   int nCmdShow) {
+  const size_t maxSize = 16 << 20;
+
+  std::vector<char> src(maxSize + MaxOffset);
+  std::vector<char> dst(maxSize + MaxOffset + GuardSize);
+  std::vector<char> ref(maxSize + MaxOffset + GuardSize);
+
+  for (size_t i = 0; i < src.size(); i++)
+    src[i] = char(i * 7 + (i >> 8));
+
+  // Cover the scalar head and tail handling as well as
+  // every vector loop with all relative alignments
+  uint32_t failures = 0;
+
+  for (size_t size = 0; size <= 512; size++) {
+    for (size_t dstOffset = 0; dstOffset < MaxOffset; dstOffset++) {
+      for (size_t srcOffset = 0; srcOffset < MaxOffset; srcOffset += 7)
+        failures += !testCopy(dst, ref, src, dstOffset, srcOffset, size);
+    }
+  }
+
+  const std::array<size_t, 5> largeSizes = {{
+    (256 << 10) - 1, 256 << 10, (1 << 20) + 33, 4 << 20, maxSize }};
+
+  for (size_t size : largeSizes) {
+    for (size_t dstOffset = 0; dstOffset < MaxOffset; dstOffset += 13) {
+      for (size_t srcOffset = 0; srcOffset < MaxOffset; srcOffset += 17)
+        failures += !testCopy(dst, ref, src, dstOffset, srcOffset, size);
+    }
+  }
+
+  if (failures) {
+    Logger::err(str::format(failures, " copies failed"));
+    return 1;
+  }
+
+  Logger::info("All copies match memcpy");
+
+  for (size_t size : largeSizes) {
+    double memcpyRate = timeCopy(dst, src, size, false);
+    double streamRate = timeCopy(dst, src, size, true);
+
+    Logger::info(str::format(size, " bytes: memcpy ",
+      uint32_t(memcpyRate), " MiB/s, streamCopy ",
+      uint32_t(streamRate), " MiB/s"));
+  }
+
+  return 0;
+}